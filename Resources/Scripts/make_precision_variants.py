@@ -0,0 +1,60 @@
+# TitanVocal - writes FP16 and INT8 sidecars next to a model for AIModelInterface::setPrecision
+#
+#   model.onnx -> model.fp16.onnx  (weights in FP16, float inputs/outputs kept)
+#                 model.int8.onnx  (dynamic INT8 quantization of MatMul/Gemm weights)
+#   model.pt   -> model.fp16.pt    (TorchScript, weights in FP16)
+#                 model.int8.pt    (TorchScript, Linear layers dynamically quantized to INT8)
+#
+# INT8 TorchScript needs the eager model, so pass --state_dict with the checkpoint written by
+# train_vocal_model.py alongside the exported model.pt.
+import argparse
+from pathlib import Path
+
+
+def onnx_variants(model_path: Path):
+    import onnx
+    from onnxconverter_common import float16
+    from onnxruntime.quantization import quantize_dynamic, QuantType
+
+    fp16 = float16.convert_float_to_float16(onnx.load(str(model_path)), keep_io_types=True)
+    onnx.save(fp16, str(model_path.with_suffix(".fp16.onnx")))
+
+    quantize_dynamic(str(model_path), str(model_path.with_suffix(".int8.onnx")),
+                     op_types_to_quantize=["MatMul", "Gemm"], weight_type=QuantType.QInt8)
+
+
+def torch_variants(model_path: Path, state_dict: Path = None):
+    import torch
+    import torch.nn as nn
+
+    scripted = torch.jit.load(str(model_path), map_location="cpu").eval()
+    torch.jit.save(scripted.half(), str(model_path.with_suffix(".fp16.pt")))
+
+    if state_dict is None:
+        print("Skipping model.int8.pt: dynamic quantization needs --state_dict")
+        return
+
+    from train_vocal_model import VocalRepairTransformer
+    model = VocalRepairTransformer()
+    model.load_state_dict(torch.load(str(state_dict), map_location="cpu"))
+    model.eval()
+    quantized = torch.ao.quantization.quantize_dynamic(model, {nn.Linear}, dtype=torch.qint8)
+    torch.jit.save(torch.jit.script(quantized), str(model_path.with_suffix(".int8.pt")))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write FP16 and INT8 sidecars for a TitanVocal model")
+    parser.add_argument("model", type=str, help="model.onnx or TorchScript model.pt")
+    parser.add_argument("--state_dict", type=str, default=None, help="training checkpoint, for INT8 TorchScript")
+    args = parser.parse_args()
+
+    model_path = Path(args.model)
+    if model_path.suffix == ".onnx":
+        onnx_variants(model_path)
+    else:
+        torch_variants(model_path, Path(args.state_dict) if args.state_dict else None)
+    print(f"Wrote precision variants next to {model_path}")
+
+
+if __name__ == "__main__":
+    main()
@@ -2,78 +2,246 @@
 #include "AIModelInterface.h"
 #include <iostream>
 
+namespace {
+    double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Shared by every interface, so a stream never mistakes one model for another
+    std::atomic<juce::uint64> nextModelSerial { 1 };
+}
+
 AIModelInterface::AIModelInterface() {
     // ONNX Runtime C++ API uses RAII via Ort::Env; no extra init needed beyond member env
 }
 
-AIModelInterface::~AIModelInterface() {
-    // Cleanup models
-    for (auto& [type, instance] : models) {
-        if (instance.isLoaded) {
-            // Proper cleanup would be needed for each model type
+AIModelInterface::~AIModelInterface() = default;
+
+bool AIModelInterface::loadModel(ModelType type, const std::string& modelPath) {
+    try {
+        auto instance = std::make_unique<ModelInstance>();
+        instance->config.type = type;
+
+        // A reduced-precision sidecar is used when there is one and it loads; otherwise the FP32 file
+        const auto variantPath = getPrecisionVariantPath(modelPath, precision);
+        bool loaded = variantPath != modelPath && loadInstance(*instance, variantPath, precision);
+        if (!loaded) {
+            loaded = loadInstance(*instance, modelPath, FP32);
+        }
+
+        if (!loaded) {
+            std::cout << "No AI backends enabled or model failed to load: " << modelPath << std::endl;
+            return false;
         }
+
+        instance->serial = nextModelSerial.fetch_add(1);
+        models.publish((size_t)type, std::move(instance));
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading model: " << e.what() << std::endl;
+        return false;
     }
 }
 
-bool AIModelInterface::loadModel(ModelType type, const std::string& modelPath) {
-    try {
-        ModelInstance instance;
-        instance.config.type = type;
-        instance.config.modelPath = modelPath;
+bool AIModelInterface::loadIdentityModel(ModelType type, int numStates) {
+    auto instance = std::make_unique<ModelInstance>();
+    instance->config.type = type;
+    instance->config.modelPath = "identity";
+    instance->config.numStates = std::max(0, numStates);
+    instance->identity = true;
+    instance->isLoaded = true;
+    if (!warmUp(*instance)) {
+        return false;
+    }
+
+    instance->serial = nextModelSerial.fetch_add(1);
+    models.publish((size_t)type, std::move(instance));
+    return true;
+}
 
-        bool loaded = false;
+bool AIModelInterface::loadInstance(ModelInstance& instance, const std::string& modelPath, int filePrecision) {
+    // Starts clean: a sidecar that loaded but failed warm-up leaves a session behind
+    const auto type = instance.config.type;
+    instance = ModelInstance();
+    instance.config.type = type;
+    instance.config.modelPath = modelPath;
+    instance.config.precision = filePrecision;
+    bool loaded = false;
 
 #if defined(ENABLE_TORCH)
-        // Try loading as Torch model first (if enabled)
+    // Try loading as Torch model first (if enabled)
+    try {
+        at::set_num_threads(threadCount);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        auto module = torch::jit::load(modelPath);
+        module.eval();
+
+        // State arguments and their starting values, read before freezing drops initial_state()
+        for (const auto& argument : module.get_method("forward").function().getSchema().arguments()) {
+            if (argument.name().rfind("state_in", 0) == 0) ++instance.config.numStates;
+        }
+        if (instance.config.numStates > 0) {
+            torch::InferenceMode inferenceMode;
+            auto initial = module.get_method("initial_state")({});
+            for (const auto& value : initial.isTuple() ? initial.toTupleRef().elements().vec() : initial.toList().vec()) {
+                instance.torchInitialState.push_back(value.toTensor());
+            }
+            if ((int)instance.torchInitialState.size() != instance.config.numStates) {
+                throw std::runtime_error("initial_state() does not match the model's state_in arguments");
+            }
+        }
+        instance.config.loadMs = millisecondsSince(start);
+
+        // Freezing turns weights and attributes into constants so optimize_for_inference can
+        // fold and prepack them. Modules with mutable attributes cannot be frozen and run as
+        // loaded (still in eval mode).
+        start = std::chrono::high_resolution_clock::now();
         try {
-            auto module = torch::jit::load(modelPath);
-            instance.torchModel = std::make_shared<torch::jit::script::Module>(std::move(module));
-            instance.isLoaded = true;
-            loaded = true;
-            std::cout << "Loaded Torch model: " << modelPath << std::endl;
+            auto frozen = torch::jit::freeze(module);
+            module = torch::jit::optimize_for_inference(frozen);
         } catch (const std::exception& e) {
-            std::cout << "Failed to load as Torch model: " << e.what() << std::endl;
+            std::cout << "Torch model not frozen, running unoptimized: " << e.what() << std::endl;
         }
+        instance.config.optimizeMs = millisecondsSince(start);
+
+        instance.torchModel = std::make_shared<torch::jit::script::Module>(std::move(module));
+        instance.isLoaded = true;
+        loaded = true;
+        std::cout << "Loaded Torch model: " << modelPath << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Failed to load as Torch model: " << e.what() << std::endl;
+    }
 #endif
 
 #if defined(ENABLE_ONNX)
-        if (!loaded) {
-            // Try loading as ONNX model (if enabled)
-            try {
-                Ort::SessionOptions sessionOptions;
-                sessionOptions.SetIntraOpNumThreads(threadCount);
-                sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
-
-                if (useGPU) {
-                    // Configure GPU settings if available (requires CUDA provider linked)
-                    Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(sessionOptions, 0));
-                }
-
-                // Precision handling note: ONNX Runtime expects model/tensor dtypes.
-                // Here we keep input as float (FP32). FP16/INT8 would require model conversion.
+    if (!loaded) {
+        // Try loading as ONNX model (if enabled)
+        try {
+            Ort::SessionOptions sessionOptions;
+            sessionOptions.SetIntraOpNumThreads(threadCount);
+            sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
 
-                instance.onnxSession = std::make_unique<Ort::Session>(env, modelPath.c_str(), sessionOptions);
-                instance.isLoaded = true;
-                loaded = true;
-                std::cout << "Loaded ONNX model: " << modelPath << std::endl;
-            } catch (const std::exception& e) {
-                std::cout << "Failed to load as ONNX model: " << e.what() << std::endl;
+            if (useGPU) {
+                // Configure GPU settings if available (requires CUDA provider linked)
+                Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(sessionOptions, 0));
             }
+
+            // FP16 and INT8 sidecars keep float inputs and outputs (the conversion script
+            // inserts the casts), so they run through the same prepared session.
+            // Names, shapes and types are read once here; frames then run through IoBinding
+            const auto start = std::chrono::high_resolution_clock::now();
+            instance.onnxSession = std::make_unique<PreparedOnnxSession>(env, modelPath, sessionOptions);
+            instance.config.loadMs = millisecondsSince(start);
+            instance.config.inputSize = instance.onnxSession->getFixedInputSize();
+            instance.config.outputSize = instance.config.inputSize;
+            instance.config.numStates = instance.onnxSession->getNumStates();
+            instance.isLoaded = true;
+            loaded = true;
+            std::cout << "Loaded ONNX model: " << modelPath << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "Failed to load as ONNX model: " << e.what() << std::endl;
         }
+    }
 #endif
 
-        if (!loaded) {
-            std::cout << "No AI backends enabled or model failed to load: " << modelPath << std::endl;
-            return false;
-        }
+    return loaded && warmUp(instance);
+}
 
-        models[type] = instance;
+bool AIModelInterface::warmUp(ModelInstance& instance) {
+    auto& config = instance.config;
+    if (warmupRuns <= 0) {
         return true;
+    }
 
+    const auto frameSizes = config.inputSize > 0 ? std::vector<int>{ config.inputSize } : warmupFrameSizes;
+    const FrameParameters parameters;
+    std::vector<double> latencies;
+
+    try {
+        for (size_t i = 0; i < frameSizes.size(); ++i) {
+            const int frameSize = frameSizes[i];
+            if (frameSize <= 0) {
+                continue;
+            }
+
+            // Quiet noise rather than silence, so nothing in the model sees a degenerate input
+            std::vector<float> input((size_t)frameSize), output((size_t)frameSize);
+            juce::Random random(1);
+            for (auto& sample : input) sample = 0.01f * (2.0f * random.nextFloat() - 1.0f);
+
+            for (int run = 0; run < warmupRuns; ++run) {
+                const auto start = std::chrono::high_resolution_clock::now();
+                if (!runInstance(instance, input.data(), frameSize, parameters, output.data(), nullptr)) {
+                    std::cout << "Model failed warm-up: " << config.modelPath << std::endl;
+                    return false;
+                }
+                const double ms = millisecondsSince(start);
+                config.warmupMs += ms;
+                ++config.warmupRuns;
+                if (config.warmupFrameSize == 0 || config.warmupFrameSize == frameSize) {
+                    config.warmupFrameSize = frameSize;
+                    latencies.push_back(ms);
+                }
+            }
+        }
     } catch (const std::exception& e) {
-        std::cerr << "Error loading model: " << e.what() << std::endl;
+        std::cout << "Model failed warm-up: " << e.what() << std::endl;
         return false;
     }
+
+    if (!latencies.empty()) {
+        config.firstInferenceMs = latencies.front();
+        std::vector<double> steady(latencies.size() > 1 ? latencies.begin() + 1 : latencies.begin(), latencies.end());
+        std::nth_element(steady.begin(), steady.begin() + (long)(steady.size() / 2), steady.end());
+        config.steadyInferenceMs = steady[steady.size() / 2];
+    }
+    return true;
+}
+
+bool AIModelInterface::runInstance(ModelInstance& model, const float* input, int numSamples,
+                                   const FrameParameters& parameters, float* output, StreamState* stream) {
+    const float values[] = { parameters.formantShift, parameters.noiseAmount,
+                             parameters.pitchAmount, parameters.saturation };
+
+    // A stream follows one model; a new model (or a reset) starts it again from zero state
+    const bool carryState = stream != nullptr && model.config.numStates > 0;
+    const bool freshState = carryState && stream->model != model.serial;
+    if (freshState) {
+        stream->model = model.serial;
+    }
+
+    if (model.identity) {
+        if (freshState) {
+            stream->values.assign((size_t)model.config.numStates, 0.0f);
+        }
+        std::copy(input, input + numSamples, output);
+        return true;
+    }
+
+#if defined(ENABLE_ONNX)
+    if (model.onnxSession) {
+        if (freshState) {
+            stream->values.assign(model.onnxSession->getStateSize(), 0.0f);
+        }
+        model.onnxSession->run(input, numSamples, values, (int) std::size(values), output,
+                               carryState ? stream->values.data() : nullptr);
+        return true;
+    }
+#endif
+#if defined(ENABLE_TORCH)
+    if (model.torchModel) {
+        if (freshState) {
+            stream->torchValues.clear();
+            for (const auto& tensor : model.torchInitialState) stream->torchValues.push_back(tensor.clone());
+        }
+        return processWithTorch(model, input, numSamples, values, (int) std::size(values), output,
+                                carryState ? &stream->torchValues : nullptr);
+    }
+#endif
+    juce::ignoreUnused(model, input, numSamples, values, output, freshState);
+    return false;
 }
 
 AIModelInterface::ProcessingResult AIModelInterface::processFrame(
@@ -83,81 +251,103 @@ AIModelInterface::ProcessingResult AIModelInterface::processFrame(
     ProcessingResult result;
     result.success = false;
 
-    auto it = models.find(type);
-    if (it == models.end() || !it->second.isLoaded) {
+    const auto instance = models.acquire((size_t)type);
+    if (!instance || !instance->isLoaded) {
         return result;
     }
 
-    auto& model = it->second;
+    auto& model = *instance;
 
     try {
 #if defined(ENABLE_TORCH)
         if (model.torchModel) {
-            result = processWithTorch(model, audioFrame, parameters);
+            std::vector<float> paramValues;
+            for (const auto& kv : parameters) paramValues.push_back(kv.second);
+
+            const auto startTime = std::chrono::high_resolution_clock::now();
+            result.processedAudio.resize(audioFrame.size());
+            result.success = processWithTorch(model, audioFrame.data(), (int)audioFrame.size(),
+                                              paramValues.data(), (int)paramValues.size(), result.processedAudio.data(), nullptr);
+            result.processingTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
         }
 #endif
 #if defined(ENABLE_ONNX)
-        else if (model.onnxSession) {
+        if (model.onnxSession) {
             result = processWithONNX(model, audioFrame, parameters);
         }
 #endif
     } catch (const std::exception& e) {
         std::cerr << "Error processing frame: " << e.what() << std::endl;
     }
+    juce::ignoreUnused(model, audioFrame, parameters);
 
     return result;
 }
 
-#if defined(ENABLE_TORCH)
-AIModelInterface::ProcessingResult AIModelInterface::processWithTorch(
-    ModelInstance& model, const std::vector<float>& audioFrame,
-    const std::map<std::string, float>& parameters) {
-
-    ProcessingResult result;
-    auto startTime = std::chrono::high_resolution_clock::now();
+bool AIModelInterface::processFrame(ModelType type, const float* input, int numSamples,
+                                    const FrameParameters& parameters, float* output, StreamState* stream) {
+    // Holding the instance keeps it alive through this frame even if it is swapped out meanwhile
+    const auto instance = models.acquire((size_t)type);
+    if (!instance || !instance->isLoaded || numSamples <= 0) {
+        return false;
+    }
 
     try {
-        // Convert to torch tensor
-        torch::Tensor inputTensor = torch::from_blob(
-            const_cast<float*>(audioFrame.data()),
-            {1, static_cast<int64_t>(audioFrame.size())}
-        ).clone();
-
-        // Prepare parameters tensor if needed
-        std::vector<torch::jit::IValue> inputs;
-        inputs.push_back(inputTensor);
-
-        // Add parameters if the model expects them
-        if (!parameters.empty()) {
-            std::vector<float> paramValues;
-            for (const auto& [key, value] : parameters) {
-                (void)key; // suppress unused warning
-                paramValues.push_back(value);
-            }
-            torch::Tensor paramTensor = torch::tensor(paramValues).unsqueeze(0);
-            inputs.push_back(paramTensor);
-        }
-
-        // Run inference
-        auto output = model.torchModel->forward(inputs);
+        return runInstance(*instance, input, numSamples, parameters, output, stream);
+    } catch (const std::exception& e) {
+        std::cerr << "Error processing frame: " << e.what() << std::endl;
+    }
 
-        if (output.isTensor()) {
-            auto outputTensor = output.toTensor();
-            result.processedAudio = std::vector<float>(
-                outputTensor.data_ptr<float>(),
-                outputTensor.data_ptr<float>() + outputTensor.numel()
-            );
-            result.success = true;
-        }
+    return false;
+}
 
-    } catch (const std::exception& e) {
-        std::cerr << "Torch processing error: " << e.what() << std::endl;
+#if defined(ENABLE_TORCH)
+bool AIModelInterface::processWithTorch(ModelInstance& model, const float* input, int numSamples,
+                                        const float* params, int numParams, float* output,
+                                        std::vector<torch::Tensor>* state)
+{
+    // No autograd recording or version counting. Input and parameters are wrapped in place, not
+    // cloned: a frozen inference module never writes to its inputs.
+    torch::InferenceMode inferenceMode;
+
+    // FP16 sidecars hold half weights, so their inputs are converted; INT8 ones take float
+    const auto inputType = model.config.precision == FP16 ? torch::kHalf : torch::kFloat;
+
+    std::vector<torch::jit::IValue> inputs;
+    inputs.reserve(2 + model.torchInitialState.size());
+    inputs.emplace_back(torch::from_blob(const_cast<float*>(input), { 1, (int64_t)numSamples }, torch::kFloat).to(inputType));
+    if (numParams > 0) {
+        inputs.emplace_back(torch::from_blob(const_cast<float*>(params), { 1, (int64_t)numParams }, torch::kFloat).to(inputType));
     }
 
-    auto endTime = std::chrono::high_resolution_clock::now();
-    result.processingTime = std::chrono::duration<double>(endTime - startTime).count();
+    // Stateful models: the stream's state, or the initial state for a one-off frame
+    const auto& stateIn = state != nullptr ? *state : model.torchInitialState;
+    for (const auto& tensor : stateIn) inputs.emplace_back(tensor);
 
-    return result;
+    const auto result = model.torchModel->forward(inputs);
+    torch::Tensor audio;
+    if (model.config.numStates > 0) {
+        // (audio, state...), the new state in the same order as the arguments
+        if (!result.isTuple() || result.toTupleRef().elements().size() != (size_t)model.config.numStates + 1) {
+            return false;
+        }
+        const auto& elements = result.toTupleRef().elements();
+        audio = elements[0].toTensor();
+        if (state != nullptr) {
+            for (size_t i = 0; i < state->size(); ++i) (*state)[i] = elements[i + 1].toTensor();
+        }
+    } else if (result.isTensor()) {
+        audio = result.toTensor();
+    } else {
+        return false;
+    }
+
+    // Straight into the caller's buffer; copy_ converts dtype or layout only if the model needs it
+    const auto processed = audio.reshape({ -1 });
+    const int64_t n = std::min<int64_t>(processed.numel(), numSamples);
+    torch::from_blob(output, { n }, torch::kFloat).copy_(processed.slice(0, 0, n));
+    std::fill(output + n, output + numSamples, 0.0f);
+    return true;
 }
 #endif
 
@@ -170,65 +360,15 @@ AIModelInterface::ProcessingResult AIModelInterface::processWithONNX(
     auto startTime = std::chrono::high_resolution_clock::now();
 
     try {
-        // Prepare input data (pad/trim to a reasonable size if config known)
-        const int targetSize = model.config.inputSize > 0 ? model.config.inputSize : (int)audioFrame.size();
-        std::vector<float> inputPadded = preprocessAudio(audioFrame, targetSize);
-
-        // Create tensor shape [1, N]
-        std::array<int64_t, 2> inputShape { 1, (int64_t)inputPadded.size() };
-
-        Ort::AllocatorWithDefaultOptions allocator;
-        size_t numInputs = model.onnxSession->GetInputCount();
-        size_t numOutputs = model.onnxSession->GetOutputCount();
-
-        const char* inputName = nullptr;
-        std::vector<const char*> inputNames;
-        for (size_t i = 0; i < numInputs; ++i)
-        {
-            auto name = model.onnxSession->GetInputNameAllocated(i, allocator);
-            inputNames.push_back(name.get());
-            if (i == 0) inputName = name.get();
-        }
-
-        std::vector<const char*> outputNames;
-        for (size_t i = 0; i < numOutputs; ++i)
-        {
-            auto name = model.onnxSession->GetOutputNameAllocated(i, allocator);
-            outputNames.push_back(name.get());
-        }
-
-        Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU);
-        Ort::Value inputTensor = Ort::Value::CreateTensor<float>(memInfo, inputPadded.data(), inputPadded.size(), inputShape.data(), inputShape.size());
-
-        std::vector<Ort::Value> inputs;
-        inputs.emplace_back(std::move(inputTensor));
-
-        // Parameters tensor (optional) if model expects a second input
-        if (!parameters.empty() && numInputs > 1)
-        {
-            std::vector<float> paramValues;
-            paramValues.reserve(parameters.size());
-            for (const auto& kv : parameters) paramValues.push_back(kv.second);
-            std::array<int64_t, 2> paramShape{ 1, (int64_t)paramValues.size() };
-            Ort::Value paramTensor = Ort::Value::CreateTensor<float>(memInfo, paramValues.data(), paramValues.size(), paramShape.data(), paramShape.size());
-            inputs.emplace_back(std::move(paramTensor));
-        }
-
-        // Run
-        auto outputValues = model.onnxSession->Run(Ort::RunOptions{ nullptr }, inputNames.data(), inputs.data(), inputs.size(), outputNames.data(), outputNames.size());
-
-        if (!outputValues.empty() && outputValues[0].IsTensor())
-        {
-            float* outData = outputValues[0].GetTensorMutableData<float>();
-            auto outTypeInfo = outputValues[0].GetTensorTypeAndShapeInfo();
-            std::vector<int64_t> outShape = outTypeInfo.GetShape();
-            size_t outCount = 1;
-            for (auto d : outShape) outCount *= (size_t)d;
-
-            std::vector<float> processed(outData, outData + outCount);
-            result.processedAudio = postprocessAudio(processed, (int)audioFrame.size());
-            result.success = true;
-        }
+        // Parameter values in key order, as a second input for models that take one
+        std::vector<float> paramValues;
+        paramValues.reserve(parameters.size());
+        for (const auto& kv : parameters) paramValues.push_back(kv.second);
+
+        result.processedAudio.resize(audioFrame.size());
+        model.onnxSession->run(audioFrame.data(), (int)audioFrame.size(), paramValues.data(), (int)paramValues.size(),
+                               result.processedAudio.data());
+        result.success = true;
     } catch (const std::exception& e) {
         std::cerr << "ONNX processing error: " << e.what() << std::endl;
     }
@@ -241,50 +381,62 @@ AIModelInterface::ProcessingResult AIModelInterface::processWithONNX(
 
 // Utility and management methods
 bool AIModelInterface::isModelLoaded(ModelType type) const {
-    auto it = models.find(type);
-    return it != models.end() && it->second.isLoaded;
+    // Only loaded instances are ever published
+    return models.isPublished((size_t)type);
+}
+
+bool AIModelInterface::isModelStateful(ModelType type) const {
+    const auto instance = models.acquire((size_t)type);
+    return instance && instance->config.numStates > 0;
+}
+
+int AIModelInterface::getModelInputSize(ModelType type) const {
+    const auto instance = models.acquire((size_t)type);
+    return instance ? instance->config.inputSize : 0;
 }
 
 void AIModelInterface::unloadModel(ModelType type) {
-    auto it = models.find(type);
-    if (it != models.end()) {
-        models.erase(it);
-    }
+    models.publish((size_t)type, nullptr);
 }
 
 std::vector<AIModelInterface::ModelType> AIModelInterface::getLoadedModels() const {
     std::vector<ModelType> loaded;
-    for (const auto& kv : models) {
-        if (kv.second.isLoaded) loaded.push_back(kv.first);
+    for (int type = 0; type < numModelTypes; ++type) {
+        if (isModelLoaded((ModelType)type)) loaded.push_back((ModelType)type);
     }
     return loaded;
 }
 
 AIModelInterface::ModelConfig AIModelInterface::getModelConfig(ModelType type) const {
-    auto it = models.find(type);
-    if (it != models.end()) return it->second.config;
-    return {};
+    const auto instance = models.acquire((size_t)type);
+    return instance ? instance->config : ModelConfig{};
 }
 
-void AIModelInterface::setThreadCount(int threads) { threadCount = std::max(1, threads); }
+void AIModelInterface::setThreadCount(int threads) {
+    threadCount = std::max(1, threads);
+#if defined(ENABLE_TORCH)
+    // LibTorch's intra-op pool is per process; ONNX sessions pick the count up at load
+    at::set_num_threads(threadCount);
+#endif
+}
 void AIModelInterface::setGPUMode(bool gpu) { useGPU = gpu; }
-void AIModelInterface::setPrecision(int p) { precision = p; }
+void AIModelInterface::setPrecision(int p) { precision = std::clamp(p, (int)FP32, (int)INT8); }
+void AIModelInterface::setWarmup(int runsPerFrameSize, const std::vector<int>& frameSizes) {
+    warmupRuns = std::max(0, runsPerFrameSize);
+    warmupFrameSizes = frameSizes;
+}
 
-std::vector<float> AIModelInterface::preprocessAudio(const std::vector<float>& audio, int targetSize) {
-    std::vector<float> out;
-    out.resize(targetSize);
-    if ((int)audio.size() >= targetSize) {
-        std::copy(audio.begin(), audio.begin() + targetSize, out.begin());
-    } else {
-        std::copy(audio.begin(), audio.end(), out.begin());
-        std::fill(out.begin() + audio.size(), out.end(), 0.0f);
+std::string AIModelInterface::getPrecisionVariantPath(const std::string& modelPath, int precision) {
+    const char* suffix = precision == FP16 ? ".fp16" : precision == INT8 ? ".int8" : nullptr;
+    const juce::String path(modelPath);
+    if (suffix == nullptr || !juce::File::isAbsolutePath(path)) {
+        return modelPath;
     }
-    return out;
-}
 
-std::vector<float> AIModelInterface::postprocessAudio(const std::vector<float>& processed, int originalSize) {
-    if ((int)processed.size() <= originalSize) return processed;
-    return std::vector<float>(processed.begin(), processed.begin() + originalSize);
+    // default.onnx -> default.int8.onnx, default.pt -> default.fp16.pt
+    const juce::File file(path);
+    const auto variant = file.getSiblingFile(file.getFileNameWithoutExtension() + suffix + file.getFileExtension());
+    return variant.existsAsFile() ? variant.getFullPathName().toStdString() : modelPath;
 }
 
 AIModelInterface::ProcessingResult AIModelInterface::processBuffer(
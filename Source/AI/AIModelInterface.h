@@ -13,10 +13,12 @@ using c10::nullopt; // prefer c10::nullopt for LibTorch optional functions
 #endif
 #if defined(ENABLE_ONNX)
 #include <onnxruntime_cxx_api.h>
+#include "PreparedOnnxSession.h"
 #endif
 #include <JuceHeader.h>
 #include <vector>
 #include <memory>
+#include "ModelRegistry.h"
 
 class AIModelInterface {
 public:
@@ -31,33 +33,95 @@ public:
         VOICE_MORPHING,
         TIMING_CORRECTION
     };
+    static constexpr int numModelTypes = TIMING_CORRECTION + 1;
+
+    enum Precision {
+        FP32 = 0,
+        FP16,       // weights in half precision
+        INT8        // dynamically quantized weights
+    };
 
     struct ModelConfig {
-        ModelType type;
+        ModelType type = NOISE_REDUCTION;
         std::string modelPath;
-        int inputSize;
-        int outputSize;
-        float complexity;
-        bool requiresGPU;
+        int inputSize = 0;      // fixed samples per frame, 0 if the model takes any length
+        int outputSize = 0;
+        float complexity = 0.0f;
+        bool requiresGPU = false;
+        int precision = FP32;   // of the file actually loaded
+        int numStates = 0;      // state tensors carried from frame to frame; 0 for a stateless model
+
+        // How long loadModel took to bring the model up, in milliseconds
+        double loadMs = 0.0;            // reading the file; ONNX Runtime optimizes the graph here too
+        double optimizeMs = 0.0;        // TorchScript freeze and optimize_for_inference
+        double warmupMs = 0.0;          // all warm-up inferences together
+        int warmupRuns = 0;
+        int warmupFrameSize = 0;        // the frame size the two latencies below were measured at
+        double firstInferenceMs = 0.0;  // the first call, which pays for kernel selection and arena growth
+        double steadyInferenceMs = 0.0; // median of the calls after it
     };
 
     struct ProcessingResult {
         std::vector<float> processedAudio;
         std::vector<float> analysisData;
-        float confidence;
-        double processingTime;
-        bool success;
+        float confidence = 0.0f;
+        double processingTime = 0.0;
+        bool success = false;
     };
 
-    // Model Management
+    // Model Management. Any thread but the audio thread may load or unload while others run
+    // frames: the model is built and warmed up aside, then swapped in with one atomic exchange. A
+    // model that is replaced or unloaded stays alive for the frames still using it and is
+    // destroyed on the registry's reclaimer thread.
     bool loadModel(ModelType type, const std::string& modelPath);
-    bool isModelLoaded(ModelType type) const;
+    // Built-in stand-in for checks and benchmarks where no model file is at hand: frames come back
+    // unchanged. With numStates > 0 it streams as a stateful model. Warmed up and published like
+    // a model file.
+    bool loadIdentityModel(ModelType type, int numStates = 0);
+    bool isModelLoaded(ModelType type) const;   // wait-free, safe on the audio thread
+    bool isModelStateful(ModelType type) const; // lock-free, safe on the audio thread
+    int getModelInputSize(ModelType type) const; // lock-free; ModelConfig::inputSize, 0 if not loaded
     void unloadModel(ModelType type);
 
+    // Per-frame parameters, in the order models receive them (alphabetical, as the map overload)
+    struct FrameParameters {
+        float formantShift = 0.0f;
+        float noiseAmount = 0.0f;
+        float pitchAmount = 0.0f;
+        float saturation = 0.0f;
+    };
+
+    // Recurrent or cached-attention state of one stream (one channel) for stateful models, which
+    // then keep their context across small frames. ONNX models declare state as inputs named
+    // state_in<suffix> fed from outputs named state_out<suffix>. TorchScript models take state
+    // tensors as forward() arguments named state_in*, after audio and parameters, return
+    // (audio, state...) and provide initial_state() returning the starting tensors. A stream
+    // starts from zero (initial) state, again after reset() and whenever the model is replaced.
+    // Only the thread running the stream's frames may touch it.
+    class StreamState {
+    public:
+        void reset() { model = 0; }
+
+    private:
+        friend class AIModelInterface;
+        juce::uint64 model = 0;         // serial of the model the values belong to
+        std::vector<float> values;      // ONNX: every state tensor back to back
+#if defined(ENABLE_TORCH)
+        std::vector<torch::Tensor> torchValues;
+#endif
+    };
+
     // Real-time Processing
     ProcessingResult processFrame(ModelType type, const std::vector<float>& audioFrame,
                                  const std::map<std::string, float>& parameters);
 
+    // Streaming path: numSamples of input straight into output (numSamples long). ONNX models run
+    // through a prepared session and allocate nothing per frame once the stream holds state for
+    // the model. Stateful models carry their state in stream; without one every frame starts
+    // from zero state. Returns false if no model of this type is loaded or inference failed.
+    bool processFrame(ModelType type, const float* input, int numSamples,
+                      const FrameParameters& parameters, float* output, StreamState* stream = nullptr);
+
     // Batch Processing (for offline mode)
     ProcessingResult processBuffer(ModelType type, const std::vector<float>& audioBuffer,
                                   const std::map<std::string, float>& parameters);
@@ -69,22 +133,34 @@ public:
     // Performance Optimization
     void setThreadCount(int threads);
     void setGPUMode(bool useGPU);
-    void setPrecision(int precision); // 0: FP32, 1: FP16, 2: INT8
+    // Precision for models loaded from now on. loadModel uses the sidecar next to the model file
+    // (model.fp16.onnx, model.int8.pt, ... as written by Resources/Scripts/make_precision_variants.py)
+    // and falls back to the FP32 file when there is none.
+    void setPrecision(int precision); // Precision
+    static std::string getPrecisionVariantPath(const std::string& modelPath, int precision);
+    // Inferences loadModel runs at each frame size before a model is published, so that the first
+    // real frame does not pay for graph optimization, kernel selection and arena growth. A model
+    // with a fixed input size is warmed up at that size only. 0 runs skips warm-up.
+    void setWarmup(int runsPerFrameSize, const std::vector<int>& frameSizes);
 
 private:
     struct ModelInstance {
         ModelConfig config;
+        juce::uint64 serial = 0;    // unique per load, so streams notice a replaced model
         // Pointers guarded by feature flags so the header compiles without the libraries
 #if defined(ENABLE_TORCH)
         std::shared_ptr<torch::jit::script::Module> torchModel; // valid when a Torch model is loaded
+        std::vector<torch::Tensor> torchInitialState;           // from initial_state(), stateful models only
 #endif
 #if defined(ENABLE_ONNX)
-        std::unique_ptr<Ort::Session> onnxSession; // valid when an ONNX model is loaded
+        std::unique_ptr<PreparedOnnxSession> onnxSession; // valid when an ONNX model is loaded
 #endif
+        bool identity = false;      // loadIdentityModel
         bool isLoaded = false;
     };
 
-    std::map<ModelType, ModelInstance> models;
+    // One slot per ModelType; frames run on a Handle, which keeps their instance alive
+    ModelRegistry<ModelInstance, (size_t) numModelTypes> models;
     // ONNX environment only when ONNX is enabled
 #if defined(ENABLE_ONNX)
     Ort::Env env{ ORT_LOGGING_LEVEL_WARNING, "TitanVocal" };
@@ -92,18 +168,22 @@ private:
     bool useGPU = false;
     int threadCount = 4;
     int precision = 0;
+    int warmupRuns = 8;
+    std::vector<int> warmupFrameSizes { 1024 };
+
+    bool loadInstance(ModelInstance& instance, const std::string& modelPath, int filePrecision);
+    bool warmUp(ModelInstance& instance);
+    bool runInstance(ModelInstance& instance, const float* input, int numSamples,
+                     const FrameParameters& parameters, float* output, StreamState* stream);
 
     // Processing methods
 #if defined(ENABLE_TORCH)
-    ProcessingResult processWithTorch(ModelInstance& model, const std::vector<float>& audioFrame,
-                                     const std::map<std::string, float>& parameters);
+    bool processWithTorch(ModelInstance& model, const float* input, int numSamples,
+                          const float* params, int numParams, float* output,
+                          std::vector<torch::Tensor>* state);
 #endif
 #if defined(ENABLE_ONNX)
     ProcessingResult processWithONNX(ModelInstance& model, const std::vector<float>& audioFrame,
                                     const std::map<std::string, float>& parameters);
 #endif
-
-    // Utility functions
-    std::vector<float> preprocessAudio(const std::vector<float>& audio, int targetSize);
-    std::vector<float> postprocessAudio(const std::vector<float>& processed, int originalSize);
 };
\ No newline at end of file
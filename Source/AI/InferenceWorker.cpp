@@ -0,0 +1,119 @@
+// TitanVocal - Proprietary Asynchronous Inference Worker Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: InferenceWorker.cpp
+// Description: Implements the job pool and worker loop for off-audio-thread AI inference.
+#include "InferenceWorker.h"
+#include "../Core/WakeSemaphore.h"
+
+InferenceWorker::InferenceWorker(AIModelInterface& aiInterface)
+    : juce::Thread("TitanVocal Inference"), ai(aiInterface), wakeUp(std::make_unique<WakeSemaphore>())
+{
+}
+
+InferenceWorker::~InferenceWorker()
+{
+    stopWorker();
+}
+
+void InferenceWorker::prepare(int frameSize, int numJobs, int numChannels)
+{
+    stopWorker();
+
+    streams.clear();
+    streams.resize((size_t) numChannels);
+
+    jobs.clear();
+    jobs.resize((size_t) numJobs);
+    for (auto& job : jobs)
+    {
+        job.input.assign((size_t) frameSize, 0.0f);
+        job.output.assign((size_t) frameSize, 0.0f);
+    }
+
+    freeJobs.prepare(numJobs);
+    pendingJobs.prepare(numJobs);
+    completedJobs.prepare(numJobs);
+    for (int i = 0; i < numJobs; ++i)
+        freeJobs.write(&i, 1);
+}
+
+void InferenceWorker::startWorker()
+{
+    if (! isThreadRunning())
+        startThread();
+}
+
+void InferenceWorker::stopWorker()
+{
+    signalThreadShouldExit();
+    wakeUp->post();
+    stopThread(2000);
+}
+
+InferenceWorker::Job* InferenceWorker::acquireJob()
+{
+    int index = -1;
+    if (freeJobs.read(&index, 1) == 0)
+        return nullptr;
+    return &jobs[(size_t) index];
+}
+
+void InferenceWorker::submit(Job* job)
+{
+    const int index = (int) (job - jobs.data());
+    pendingJobs.write(&index, 1);
+    wakeUp->post();
+}
+
+InferenceWorker::Job* InferenceWorker::popCompleted()
+{
+    int index = -1;
+    if (completedJobs.read(&index, 1) == 0)
+        return nullptr;
+    return &jobs[(size_t) index];
+}
+
+void InferenceWorker::release(Job* job)
+{
+    const int index = (int) (job - jobs.data());
+    freeJobs.write(&index, 1);
+}
+
+void InferenceWorker::run()
+{
+    // Woken as soon as a frame is submitted. A post may find its job already taken by an earlier
+    // pass; the extra wake-up then drains nothing. The timeout only bounds how long stopping takes.
+    while (! threadShouldExit())
+    {
+        wakeUp->waitFor(100);
+
+        int index = -1;
+        while (pendingJobs.read(&index, 1) == 1)
+        {
+            process(jobs[(size_t) index]);
+            completedJobs.write(&index, 1);
+            if (threadShouldExit())
+                return;
+        }
+    }
+}
+
+void InferenceWorker::process(Job& job)
+{
+    AIModelInterface::FrameParameters params;
+    params.pitchAmount = job.pitchAmount;
+    params.formantShift = job.formantShift;
+    params.noiseAmount = job.noiseAmount;
+    params.saturation = job.saturation;
+
+    // Frames of a channel arrive in order, so its state follows the channel's audio
+    auto* stream = job.channel < (int) streams.size() ? &streams[(size_t) job.channel] : nullptr;
+    if (stream != nullptr && job.resetState)
+        stream->reset();
+
+    // Straight into the job's output; input and output are the same length
+    jassert(job.output.size() == job.input.size());
+    job.success = ai.processFrame(job.modelType, job.input.data(), (int) job.input.size(), params, job.output.data(), stream);
+}
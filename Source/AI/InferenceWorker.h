@@ -0,0 +1,68 @@
+// TitanVocal - Proprietary Asynchronous Inference Worker
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: InferenceWorker.h
+// Description: Background thread that runs AI frames off the audio thread via lock-free job queues.
+#pragma once
+
+#include <JuceHeader.h>
+#include "AIModelInterface.h"
+#include "../Core/SpscRingBuffer.h"
+#include <memory>
+
+class WakeSemaphore;
+
+class InferenceWorker : private juce::Thread
+{
+public:
+    // A preallocated frame travelling audio thread -> worker -> audio thread.
+    struct Job
+    {
+        int channel = 0;
+        juce::uint32 generation = 0;
+        AIModelInterface::ModelType modelType = AIModelInterface::NOISE_REDUCTION;
+
+        // Parameter snapshot taken when the frame was submitted
+        float pitchAmount = 0.0f;
+        float formantShift = 0.0f;
+        float noiseAmount = 0.0f;
+        float saturation = 0.0f;
+
+        std::vector<float> input;   // frameSize samples, filled by the audio thread
+        std::vector<float> output;  // frameSize samples, filled by the worker
+        bool resetState = false;    // start the channel's model state afresh with this frame
+        bool success = false;
+    };
+
+    explicit InferenceWorker(AIModelInterface& aiInterface);
+    ~InferenceWorker() override;
+
+    // Not real-time safe: allocates the job pool and one model state stream per channel. Stops the
+    // thread if it is running.
+    void prepare(int frameSize, int numJobs, int numChannels);
+    void startWorker();
+    void stopWorker();
+
+    // Audio thread API (no locks; submit wakes the worker with a semaphore post). acquireJob
+    // returns nullptr when every job is in flight.
+    Job* acquireJob();
+    void submit(Job* job);
+    Job* popCompleted();
+    void release(Job* job);
+
+private:
+    AIModelInterface& ai;
+    std::vector<Job> jobs;
+    std::vector<AIModelInterface::StreamState> streams;     // worker thread only, per channel
+
+    SpscRingBuffer<int> freeJobs;       // audio thread only
+    SpscRingBuffer<int> pendingJobs;    // audio thread -> worker
+    SpscRingBuffer<int> completedJobs;  // worker -> audio thread
+    std::unique_ptr<WakeSemaphore> wakeUp;  // posted once per submitted job
+
+    void run() override;
+    void process(Job& job);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InferenceWorker)
+};
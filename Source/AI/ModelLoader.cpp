@@ -0,0 +1,66 @@
+// TitanVocal - Proprietary Background Model Loader Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: ModelLoader.cpp
+// Description: Implements the load queue and loader thread loop.
+#include "ModelLoader.h"
+
+ModelLoader::ModelLoader(AIModelInterface& aiInterface)
+    : juce::Thread("TitanVocal Model Loader"), ai(aiInterface)
+{
+}
+
+ModelLoader::~ModelLoader()
+{
+    // A load cannot be interrupted; killing the thread halfway through one would leak the session
+    stopThread(-1);
+}
+
+void ModelLoader::requestLoad(AIModelInterface::ModelType type, const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock (queueLock);
+        auto& flag = loading[(size_t) type];
+        if (flag.load(std::memory_order_relaxed) || failedPaths[(size_t) type] == path)
+            return;
+
+        flag.store(true, std::memory_order_release);
+        queue.push_back({ type, path });
+    }
+
+    if (! isThreadRunning())
+        startThread();
+    notify();
+}
+
+void ModelLoader::run()
+{
+    while (! threadShouldExit())
+    {
+        Request request;
+        bool haveRequest = false;
+        {
+            std::lock_guard<std::mutex> lock (queueLock);
+            if (! queue.empty())
+            {
+                request = std::move(queue.front());
+                queue.erase(queue.begin());
+                haveRequest = true;
+            }
+        }
+
+        if (haveRequest)
+        {
+            if (! ai.loadModel(request.type, request.path))
+            {
+                std::lock_guard<std::mutex> lock (queueLock);
+                failedPaths[(size_t) request.type] = request.path;
+            }
+            loading[(size_t) request.type].store(false, std::memory_order_release);
+            continue;
+        }
+
+        wait(-1);
+    }
+}
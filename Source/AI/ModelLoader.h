@@ -0,0 +1,48 @@
+// TitanVocal - Proprietary Background Model Loader
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ModelLoader.h
+// Description: Loads AI models on a background thread.
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "AIModelInterface.h"
+
+// prepareToPlay and the message thread only queue loads here, so neither waits seconds for a
+// transformer to load and warm up. AIModelInterface publishes each model as soon as it is ready;
+// callers ask it (isModelLoaded), not the loader, whether a model can run.
+class ModelLoader : private juce::Thread
+{
+public:
+    explicit ModelLoader(AIModelInterface& aiInterface);
+    ~ModelLoader() override;
+
+    // Not for the audio thread. Queues a load of path for type and starts the thread if needed.
+    // Ignored while a load for type is queued or running, and for a path that already failed.
+    void requestLoad(AIModelInterface::ModelType type, const std::string& path);
+
+private:
+    struct Request
+    {
+        AIModelInterface::ModelType type = AIModelInterface::NOISE_REDUCTION;
+        std::string path;
+    };
+
+    AIModelInterface& ai;
+    // Set from requestLoad until the load has succeeded or failed; only de-duplicates requests
+    std::array<std::atomic<bool>, AIModelInterface::numModelTypes> loading {};
+
+    std::mutex queueLock;
+    std::vector<Request> queue;
+    std::array<std::string, AIModelInterface::numModelTypes> failedPaths;
+
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModelLoader)
+};
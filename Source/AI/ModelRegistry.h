@@ -0,0 +1,181 @@
+// TitanVocal - Proprietary Model Registry
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ModelRegistry.h
+// Description: Fixed slots of atomically swappable, reference-counted model instances with deferred reclamation.
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// One slot per model type, each an atomic pointer to the published instance. Looking up whether a
+// slot is filled is a single atomic load; taking a Handle to an instance is lock-free. Publishing
+// swaps the pointer and retires the old instance, which a background reclaimer destroys once no
+// Handle refers to it and no thread can still be on its way to taking one.
+template <typename Instance, size_t numSlots>
+class ModelRegistry
+{
+    struct Entry
+    {
+        explicit Entry(std::unique_ptr<Instance> i) : instance(std::move(i)) {}
+        std::unique_ptr<Instance> instance;
+        std::atomic<int> users { 0 };
+    };
+
+public:
+    // Keeps an instance alive while held, even after it has been swapped out. Move-only.
+    class Handle
+    {
+    public:
+        Handle() = default;
+        Handle(Handle&& other) noexcept : entry(std::exchange(other.entry, nullptr)) {}
+        Handle& operator= (Handle&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                entry = std::exchange(other.entry, nullptr);
+            }
+            return *this;
+        }
+        ~Handle() { release(); }
+
+        explicit operator bool() const { return entry != nullptr; }
+        Instance* get() const { return entry != nullptr ? entry->instance.get() : nullptr; }
+        Instance* operator->() const { return get(); }
+        Instance& operator*() const { return *get(); }
+
+    private:
+        friend class ModelRegistry;
+        explicit Handle(Entry* e) : entry(e) {}
+        void release()
+        {
+            if (entry != nullptr)
+                entry->users.fetch_sub(1, std::memory_order_release);
+            entry = nullptr;
+        }
+
+        Entry* entry = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE(Handle)
+    };
+
+    ModelRegistry() = default;
+
+    // Nothing may hold a Handle or call in from another thread by now
+    ~ModelRegistry()
+    {
+        reclaimer.stopThread(-1);
+        for (auto& slot : slots)
+            delete slot.exchange(nullptr);
+        for (auto* entry : retired)
+            delete entry;
+    }
+
+    // Any thread, wait-free
+    bool isPublished(size_t slot) const
+    {
+        return slot < numSlots && slots[slot].load(std::memory_order_acquire) != nullptr;
+    }
+
+    // Any thread, lock-free. An empty handle if nothing is published in the slot.
+    Handle acquire(size_t slot) const
+    {
+        if (slot >= numSlots)
+            return {};
+
+        // The reclaimer frees nothing while a thread is between loading the pointer and counting
+        // itself as a user, so the entry loaded here cannot disappear before the increment
+        acquiring.fetch_add(1, std::memory_order_seq_cst);
+        auto* entry = slots[slot].load(std::memory_order_seq_cst);
+        if (entry != nullptr)
+            entry->users.fetch_add(1, std::memory_order_seq_cst);
+        acquiring.fetch_sub(1, std::memory_order_seq_cst);
+        return Handle(entry);
+    }
+
+    // Not for the audio thread (it allocates and may start the reclaimer). nullptr empties the
+    // slot. The previous instance is retired, never destroyed here.
+    void publish(size_t slot, std::unique_ptr<Instance> instance)
+    {
+        if (slot >= numSlots)
+            return;
+
+        auto* entry = instance != nullptr ? new Entry(std::move(instance)) : nullptr;
+        auto* previous = slots[slot].exchange(entry, std::memory_order_seq_cst);
+        if (previous == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock (retiredLock);
+        retired.push_back(previous);
+        reclaimer.start();
+    }
+
+    // Destroys the retired instances nobody holds any more. The reclaimer runs this; anything
+    // that is not the audio thread may too.
+    void reclaim()
+    {
+        std::vector<Entry*> unused;
+        {
+            std::lock_guard<std::mutex> lock (retiredLock);
+
+            // Everything in the list was swapped out before this point, so once no acquire is in
+            // flight, no thread can take a new reference to any of it and the counts are final
+            if (acquiring.load(std::memory_order_seq_cst) != 0)
+                return;
+
+            auto firstUnused = std::partition(retired.begin(), retired.end(),
+                                              [](const Entry* e) { return e->users.load(std::memory_order_acquire) > 0; });
+            unused.assign(firstUnused, retired.end());
+            retired.erase(firstUnused, retired.end());
+        }
+
+        // Sessions and modules are torn down outside the lock
+        for (auto* entry : unused)
+            delete entry;
+    }
+
+private:
+    class Reclaimer : private juce::Thread
+    {
+    public:
+        explicit Reclaimer(ModelRegistry& r) : juce::Thread("TitanVocal Model Reclaimer"), registry(r) {}
+        ~Reclaimer() override { stopThread(-1); }
+
+        void start()
+        {
+            if (! isThreadRunning())
+                startThread();
+        }
+        using juce::Thread::stopThread;
+
+    private:
+        static constexpr int intervalMs = 250;
+        ModelRegistry& registry;
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                registry.reclaim();
+                wait(intervalMs);
+            }
+        }
+    };
+
+    std::array<std::atomic<Entry*>, numSlots> slots {};
+    mutable std::atomic<int> acquiring { 0 };
+
+    std::mutex retiredLock;
+    std::vector<Entry*> retired;
+    Reclaimer reclaimer { *this };
+
+    JUCE_DECLARE_NON_COPYABLE(ModelRegistry)
+};
@@ -0,0 +1,234 @@
+// TitanVocal - Proprietary Prepared ONNX Session Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: PreparedOnnxSession.cpp
+// Description: Caches ONNX model metadata at load and runs frames through pooled IoBindings.
+#include "PreparedOnnxSession.h"
+
+#if defined(ENABLE_ONNX)
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // Dynamic dimensions become 1 on the batch axis and length everywhere else
+    std::vector<int64_t> resolveShape(const std::vector<int64_t>& shape, int64_t length)
+    {
+        auto resolved = shape;
+        for (size_t d = 0; d < resolved.size(); ++d)
+            if (resolved[d] <= 0)
+                resolved[d] = d == 0 ? 1 : length;
+        return resolved;
+    }
+
+    size_t elementCount(const std::vector<int64_t>& shape)
+    {
+        size_t count = 1;
+        for (auto d : shape)
+            count *= (size_t) d;
+        return count;
+    }
+
+    bool isFloatTensor(const Ort::TypeInfo& info)
+    {
+        return info.GetONNXType() == ONNX_TYPE_TENSOR
+            && info.GetTensorTypeAndShapeInfo().GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+    }
+
+    const std::string stateInputPrefix = "state_in";
+    const std::string stateOutputPrefix = "state_out";
+
+    bool hasPrefix(const std::string& name, const std::string& prefix)
+    {
+        return name.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+PreparedOnnxSession::PreparedOnnxSession(Ort::Env& env, const std::string& modelPath, const Ort::SessionOptions& options)
+    : session(env, modelPath.c_str(), options),
+      memoryInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault))
+{
+    Ort::AllocatorWithDefaultOptions allocator;
+
+    for (size_t i = 0; i < session.GetInputCount(); ++i)
+    {
+        const auto info = session.GetInputTypeInfo(i);
+        if (! isFloatTensor(info))
+            throw std::runtime_error("model input " + std::to_string(i) + " is not a float tensor");
+
+        TensorInfo tensor { session.GetInputNameAllocated(i, allocator).get(), info.GetTensorTypeAndShapeInfo().GetShape() };
+        if (hasPrefix(tensor.name, stateInputPrefix))
+            states.push_back({ std::move(tensor), {}, {}, 0 });
+        else
+            inputs.push_back(std::move(tensor));
+    }
+
+    for (size_t i = 0; i < session.GetOutputCount(); ++i)
+    {
+        const auto info = session.GetOutputTypeInfo(i);
+        TensorInfo tensor { session.GetOutputNameAllocated(i, allocator).get(),
+                            info.GetONNXType() == ONNX_TYPE_TENSOR ? info.GetTensorTypeAndShapeInfo().GetShape() : std::vector<int64_t>() };
+
+        // state_out<suffix> feeds state_in<suffix> of the next frame
+        auto state = std::find_if(states.begin(), states.end(), [&](const StateInfo& s)
+        {
+            return hasPrefix(tensor.name, stateOutputPrefix)
+                && s.input.name.compare(stateInputPrefix.size(), std::string::npos, tensor.name, stateOutputPrefix.size(), std::string::npos) == 0;
+        });
+        if (state != states.end())
+        {
+            if (! isFloatTensor(info))
+                throw std::runtime_error("state output " + tensor.name + " is not a float tensor");
+            state->output = std::move(tensor);
+            continue;
+        }
+
+        if (outputs.empty() && ! isFloatTensor(info))
+            throw std::runtime_error("model audio output " + tensor.name + " is not a float tensor");
+        outputs.push_back(std::move(tensor));
+    }
+
+    if (inputs.empty() || inputs.size() > 2 || outputs.empty())
+        throw std::runtime_error("expected an audio input, an optional parameter input and at least one output");
+
+    for (auto& state : states)
+    {
+        if (state.output.name.empty())
+            throw std::runtime_error("state input " + state.input.name + " has no " + stateOutputPrefix + " output to feed it");
+        if (std::any_of(state.input.shape.begin() + (state.input.shape.empty() ? 0 : 1), state.input.shape.end(), [](int64_t d) { return d <= 0; }))
+            throw std::runtime_error("state input " + state.input.name + " needs a fixed shape");
+
+        state.shape = resolveShape(state.input.shape, 1);
+        state.size = elementCount(state.shape);
+        stateSize += state.size;
+    }
+
+    const auto& audioShape = inputs[0].shape;
+    const bool dynamic = std::any_of(audioShape.begin() + (audioShape.empty() ? 0 : 1), audioShape.end(), [](int64_t d) { return d <= 0; });
+    fixedInputSize = dynamic ? 0 : (int) elementCount(resolveShape(audioShape, 1));
+}
+
+void PreparedOnnxSession::run(const float* input, int numSamples, const float* params, int numParams, float* output,
+                              float* state)
+{
+    auto binding = acquireBinding(numSamples, numParams);
+
+    const size_t numIn = std::min(binding->input.size(), (size_t) numSamples);
+    std::copy(input, input + numIn, binding->input.begin());
+    std::fill(binding->input.begin() + (long) numIn, binding->input.end(), 0.0f);
+
+    if (! binding->params.empty())
+    {
+        const size_t numCopied = std::min(binding->params.size(), (size_t) numParams);
+        std::copy(params, params + numCopied, binding->params.begin());
+        std::fill(binding->params.begin() + (long) numCopied, binding->params.end(), 0.0f);
+    }
+
+    for (size_t s = 0, offset = 0; s < states.size(); offset += states[s].size, ++s)
+    {
+        auto& in = binding->stateIn[s];
+        if (state != nullptr)
+            std::copy(state + offset, state + offset + in.size(), in.begin());
+        else
+            std::fill(in.begin(), in.end(), 0.0f);
+    }
+
+    try
+    {
+        session.Run(runOptions, *binding->ioBinding);
+    }
+    catch (...)
+    {
+        releaseBinding(std::move(binding));
+        throw;
+    }
+
+    const size_t numOut = std::min(binding->output.size(), (size_t) numSamples);
+    std::copy(binding->output.begin(), binding->output.begin() + (long) numOut, output);
+    std::fill(output + numOut, output + numSamples, 0.0f);
+
+    if (state != nullptr)
+        for (size_t s = 0, offset = 0; s < states.size(); offset += states[s].size, ++s)
+            std::copy(binding->stateOut[s].begin(), binding->stateOut[s].end(), state + offset);
+
+    releaseBinding(std::move(binding));
+}
+
+std::unique_ptr<PreparedOnnxSession::Binding> PreparedOnnxSession::acquireBinding(int numSamples, int numParams)
+{
+    {
+        std::lock_guard<std::mutex> lock (bindingLock);
+        for (auto it = freeBindings.begin(); it != freeBindings.end(); ++it)
+        {
+            if ((*it)->numSamples == numSamples && (*it)->numParams == numParams)
+            {
+                auto binding = std::move(*it);
+                freeBindings.erase(it);
+                return binding;
+            }
+        }
+    }
+
+    // First frame of this length on this many threads at once: build one outside the lock
+    return createBinding(numSamples, numParams);
+}
+
+void PreparedOnnxSession::releaseBinding(std::unique_ptr<Binding> binding)
+{
+    std::lock_guard<std::mutex> lock (bindingLock);
+    freeBindings.push_back(std::move(binding));
+}
+
+std::unique_ptr<PreparedOnnxSession::Binding> PreparedOnnxSession::createBinding(int numSamples, int numParams)
+{
+    auto binding = std::make_unique<Binding>();
+    binding->numSamples = numSamples;
+    binding->numParams = numParams;
+    binding->ioBinding = std::make_unique<Ort::IoBinding>(session);
+
+    binding->inputShape = resolveShape(inputs[0].shape, numSamples);
+    binding->input.assign(elementCount(binding->inputShape), 0.0f);
+    binding->inputValue = Ort::Value::CreateTensor<float>(memoryInfo, binding->input.data(), binding->input.size(),
+                                                          binding->inputShape.data(), binding->inputShape.size());
+    binding->ioBinding->BindInput(inputs[0].name.c_str(), binding->inputValue);
+
+    if (inputs.size() > 1)
+    {
+        binding->paramShape = resolveShape(inputs[1].shape, std::max(1, numParams));
+        binding->params.assign(elementCount(binding->paramShape), 0.0f);
+        binding->paramValue = Ort::Value::CreateTensor<float>(memoryInfo, binding->params.data(), binding->params.size(),
+                                                              binding->paramShape.data(), binding->paramShape.size());
+        binding->ioBinding->BindInput(inputs[1].name.c_str(), binding->paramValue);
+    }
+
+    // Audio out is assumed to run along the same time axis as audio in
+    binding->outputShape = resolveShape(outputs[0].shape, (int64_t) binding->input.size());
+    binding->output.assign(elementCount(binding->outputShape), 0.0f);
+    binding->outputValue = Ort::Value::CreateTensor<float>(memoryInfo, binding->output.data(), binding->output.size(),
+                                                           binding->outputShape.data(), binding->outputShape.size());
+    binding->ioBinding->BindOutput(outputs[0].name.c_str(), binding->outputValue);
+
+    // State goes in and comes out through buffers of the binding's own; run() copies it across
+    binding->stateIn.reserve(states.size());
+    binding->stateOut.reserve(states.size());
+    binding->stateValues.reserve(2 * states.size());
+    for (const auto& state : states)
+    {
+        auto& in = binding->stateIn.emplace_back(state.size, 0.0f);
+        auto& out = binding->stateOut.emplace_back(state.size, 0.0f);
+        auto& inValue = binding->stateValues.emplace_back(Ort::Value::CreateTensor<float>(memoryInfo, in.data(), in.size(),
+                                                                                           state.shape.data(), state.shape.size()));
+        auto& outValue = binding->stateValues.emplace_back(Ort::Value::CreateTensor<float>(memoryInfo, out.data(), out.size(),
+                                                                                            state.shape.data(), state.shape.size()));
+        binding->ioBinding->BindInput(state.input.name.c_str(), inValue);
+        binding->ioBinding->BindOutput(state.output.name.c_str(), outValue);
+    }
+
+    // Anything else the model produces (analysis) is left to the runtime's allocator
+    for (size_t i = 1; i < outputs.size(); ++i)
+        binding->ioBinding->BindOutput(outputs[i].name.c_str(), memoryInfo);
+
+    return binding;
+}
+#endif
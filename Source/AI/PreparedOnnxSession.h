@@ -0,0 +1,90 @@
+// TitanVocal - Proprietary Prepared ONNX Session
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: PreparedOnnxSession.h
+// Description: ONNX Runtime session with cached I/O metadata and preallocated, IoBinding-bound tensors.
+#pragma once
+
+#if defined(ENABLE_ONNX)
+#include <onnxruntime_cxx_api.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Everything about the model's inputs and outputs (names, shapes, element types) is read once at
+// load. Each frame length then gets a Binding: input, parameter and output tensors over buffers it
+// owns, bound to the session through Ort::IoBinding. Running a frame is a copy in, Run and a copy
+// out, with nothing allocated. Bindings are pooled, so the inference worker and the offline pool
+// threads can run frames at the same time, each with its own.
+//
+// Stateful models (GRU, LSTM, cached attention) declare each state tensor as an input named
+// state_in<suffix> and the next frame's value as the output state_out<suffix>. The caller keeps
+// the values between frames (see AIModelInterface::StreamState); state needs a fixed shape apart
+// from the batch axis.
+class PreparedOnnxSession
+{
+public:
+    // Throws Ort::Exception if the model cannot be loaded, std::runtime_error if it does not take an
+    // audio tensor plus an optional parameter vector, all float.
+    PreparedOnnxSession(Ort::Env& env, const std::string& modelPath, const Ort::SessionOptions& options);
+
+    // Samples per frame the model was exported with, or 0 if its time axis is dynamic
+    int getFixedInputSize() const { return fixedInputSize; }
+
+    // State tensors, and the floats they take together (all of them back to back, in input order)
+    int getNumStates() const { return (int) states.size(); }
+    size_t getStateSize() const { return stateSize; }
+
+    // Runs numSamples of input, padded or trimmed to the model's input size, with numParams
+    // parameter values (ignored by models without a parameter input). Writes numSamples of output,
+    // zero-filled past the end of the model's output. For a stateful model, state (getStateSize()
+    // floats) is read before the run and overwritten with the new state after it; without it the
+    // frame starts from zero state and the new state is dropped. Allocates only the first time a
+    // frame length is seen. Throws Ort::Exception on failure.
+    void run(const float* input, int numSamples, const float* params, int numParams, float* output,
+             float* state = nullptr);
+
+private:
+    struct TensorInfo
+    {
+        std::string name;
+        std::vector<int64_t> shape;     // -1 for dynamic dimensions
+    };
+
+    struct StateInfo
+    {
+        TensorInfo input, output;
+        std::vector<int64_t> shape;     // resolved
+        size_t size = 0;
+    };
+
+    struct Binding
+    {
+        int numSamples = 0;
+        int numParams = 0;
+        std::vector<float> input, params, output;
+        std::vector<int64_t> inputShape, paramShape, outputShape;
+        Ort::Value inputValue { nullptr }, paramValue { nullptr }, outputValue { nullptr };
+        std::vector<std::vector<float>> stateIn, stateOut;
+        std::vector<Ort::Value> stateValues;
+        std::unique_ptr<Ort::IoBinding> ioBinding;
+    };
+
+    Ort::Session session;
+    Ort::MemoryInfo memoryInfo;
+    Ort::RunOptions runOptions;
+    std::vector<TensorInfo> inputs, outputs;    // audio (+ parameters) in, audio (+ extras) out
+    std::vector<StateInfo> states;
+    size_t stateSize = 0;
+    int fixedInputSize = 0;
+
+    std::mutex bindingLock;     // worker threads only; held just to pop or push a binding
+    std::vector<std::unique_ptr<Binding>> freeBindings;
+
+    std::unique_ptr<Binding> acquireBinding(int numSamples, int numParams);
+    void releaseBinding(std::unique_ptr<Binding> binding);
+    std::unique_ptr<Binding> createBinding(int numSamples, int numParams);
+};
+#endif
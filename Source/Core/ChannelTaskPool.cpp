@@ -0,0 +1,145 @@
+// TitanVocal - Proprietary Channel Task Pool Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: ChannelTaskPool.cpp
+// Description: Implements the worker threads, lock-free task claiming and real-time wake-up.
+#include "ChannelTaskPool.h"
+#include "RealtimeSanitizer.h"
+#include "WakeSemaphore.h"
+#include <thread>
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace
+{
+    constexpr int maxSpinsBeforeYield = 256;
+
+    inline void spinPause()
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && (defined(__GNUC__) || defined(__clang__))
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+}
+
+//==============================================================================
+class ChannelTaskPool::Worker : public juce::Thread
+{
+public:
+    Worker(ChannelTaskPool& owner, int index)
+        : juce::Thread("TitanVocal Channels " + juce::String(index + 1)), pool(owner) {}
+
+    void run() override
+    {
+        // The timeout only bounds how long shutdown waits for us
+        while (! threadShouldExit())
+        {
+            pool.wakeUp->waitFor(100);
+            if (! threadShouldExit())
+                pool.runAvailableTasks();
+        }
+    }
+
+private:
+    ChannelTaskPool& pool;
+};
+
+//==============================================================================
+ChannelTaskPool::ChannelTaskPool() : wakeUp(std::make_unique<WakeSemaphore>()) {}
+
+ChannelTaskPool::~ChannelTaskPool()
+{
+    shutdown();
+}
+
+void ChannelTaskPool::prepare(int numWorkers, double callbackPeriodMs)
+{
+    shutdown();
+    overrunTicks = (juce::int64) (callbackPeriodMs * 0.001 * (double) juce::Time::getHighResolutionTicksPerSecond());
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, i));
+        auto& worker = *workers.back();
+
+        // Same class as the audio thread; the period lets macOS schedule them as audio work
+        const bool realtime = callbackPeriodMs > 0.0
+                              && worker.startRealtimeThread(juce::Thread::RealtimeOptions().withPriority(10).withPeriodMs(callbackPeriodMs));
+        if (! realtime)
+            worker.startThread(juce::Thread::Priority::highest);
+    }
+}
+
+void ChannelTaskPool::shutdown()
+{
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+    wakeUp->post((int) workers.size());
+    for (auto& worker : workers)
+        worker->stopThread(1000);
+    workers.clear();
+}
+
+void ChannelTaskPool::run(TaskFunction task, void* context, int numTasks)
+{
+    if (numTasks <= 0)
+        return;
+
+    if (workers.empty() || numTasks == 1)
+    {
+        for (int i = 0; i < numTasks; ++i)
+            task(context, i);
+        return;
+    }
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    currentTask.store(task, std::memory_order_relaxed);
+    currentContext.store(context, std::memory_order_relaxed);
+    remainingTasks.store(numTasks, std::memory_order_relaxed);
+    claimState.store((juce::uint64) numTasks << 32, std::memory_order_release);
+
+    wakeUp->post(juce::jmin((int) workers.size(), numTasks - 1));
+
+    // Takes every task no worker has claimed yet, however long the workers take to wake
+    runAvailableTasks();
+
+    // Whatever is left is already running on a worker, so it is a task's length away at most.
+    // Spin briefly, then give the core up in case that worker shares it. There is no giving up on
+    // it (see the class comment); a wait past the callback period is only counted.
+    bool overran = false;
+    for (int spins = 0; remainingTasks.load(std::memory_order_acquire) > 0; ++spins)
+    {
+        if (spins < maxSpinsBeforeYield)
+        {
+            spinPause();
+            continue;
+        }
+
+        std::this_thread::yield();
+        if (! overran && overrunTicks > 0 && juce::Time::getHighResolutionTicks() - start > overrunTicks)
+        {
+            overran = true;
+            overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ChannelTaskPool::runAvailableTasks()
+{
+    TITANVOCAL_RT_SCOPE();
+
+    for (;;)
+    {
+        const auto claimed = claimState.fetch_add(1, std::memory_order_acq_rel);
+        const auto index = (juce::uint32) (claimed & 0xffffffffu);
+        if (index >= (juce::uint32) (claimed >> 32))
+            return;
+
+        currentTask.load(std::memory_order_relaxed)(currentContext.load(std::memory_order_relaxed), (int) index);
+        remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,66 @@
+// TitanVocal - Proprietary Channel Task Pool
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ChannelTaskPool.h
+// Description: Small real-time worker pool that runs independent per-channel tasks inside one audio callback.
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class WakeSemaphore;
+
+// The calling (audio) thread takes part in every run, and it only returns once every task has
+// finished. Workers sleep on a semaphore. Posting to it is a single futex/kernel wake with no lock,
+// so waking them is real-time safe. Tasks are claimed from a shared atomic counter and the caller
+// keeps claiming until none are left, so a worker that wakes late never delays a run: the caller
+// only ever waits for tasks a worker has already started. Serving an audio callback, workers run
+// as real-time threads so that such a task is not preempted by ordinary threads.
+//
+// That wait is not bounded. Returning before a started task finishes would leave its worker
+// writing into buffers the callback has moved on from, so a worker that is preempted mid-task (or
+// runs at normal priority because the system refused a real-time thread) delays the callback by
+// as long. A run still waiting a whole callback period after it started counts an overrun.
+class ChannelTaskPool
+{
+public:
+    using TaskFunction = void (*)(void* context, int taskIndex);
+
+    ChannelTaskPool();
+    ~ChannelTaskPool();
+
+    // Not real-time safe: stops any running workers and starts numWorkers new ones (0 = run inline).
+    // With the period of the audio callback the pool serves, workers are real-time threads
+    // (normal high priority if the system refuses); 0 is for offline renders, which may use every
+    // core and should not starve the rest of the system.
+    void prepare(int numWorkers, double callbackPeriodMs = 0.0);
+    void shutdown();
+    int getNumWorkers() const { return (int) workers.size(); }
+    int getNumOverruns() const { return overruns.load(std::memory_order_relaxed); }
+
+    // Audio thread: runs task(context, i) for every i in [0, numTasks) and returns when all are done.
+    void run(TaskFunction task, void* context, int numTasks);
+
+private:
+    class Worker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<WakeSemaphore> wakeUp;
+
+    // Task count in the high 32 bits and next task index in the low 32, so a worker that wakes
+    // late can never claim an index against the wrong run's count.
+    std::atomic<juce::uint64> claimState { 0 };
+    std::atomic<int> remainingTasks { 0 };
+    std::atomic<TaskFunction> currentTask { nullptr };
+    std::atomic<void*> currentContext { nullptr };
+
+    juce::int64 overrunTicks { 0 };     // one callback period; 0 offline, where nothing overruns
+    std::atomic<int> overruns { 0 };
+
+    void runAvailableTasks();
+
+    JUCE_DECLARE_NON_COPYABLE(ChannelTaskPool)
+};
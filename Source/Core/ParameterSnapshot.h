@@ -0,0 +1,129 @@
+// TitanVocal - Proprietary Parameter Snapshot
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ParameterSnapshot.h
+// Description: Cached APVTS handles plus per-sample smoothing ramps, refreshed once per block.
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "QuantumParameters.h"
+#include "../DSP/FastMath.h"
+
+// Linear ramp towards a target over a fixed number of samples. fill() writes the ramp in closed
+// form (no loop-carried dependency) so the compiler can vectorise it.
+class LinearRamp
+{
+public:
+    void reset(float value) { current = target = value; step = 0.0f; remaining = 0; }
+    void setRampLength(int numSamples) { rampLength = juce::jmax(1, numSamples); }
+
+    void setTarget(float newTarget)
+    {
+        if (newTarget == target)
+            return;
+        target = newTarget;
+        remaining = rampLength;
+        step = (target - current) / (float) rampLength;
+    }
+
+    void fill(float* dest, int numSamples)
+    {
+        const int numRamped = juce::jmin(numSamples, remaining);
+        const float start = current;
+        const float delta = step;
+        for (int i = 0; i < numRamped; ++i)
+            dest[i] = start + delta * (float) (i + 1);
+        for (int i = numRamped; i < numSamples; ++i)
+            dest[i] = target;
+
+        remaining -= numRamped;
+        current = remaining > 0 ? start + delta * (float) numRamped : target;
+    }
+
+    float getCurrentValue() const { return current; }
+    bool isSmoothing() const { return remaining > 0; }
+
+private:
+    float current { 0.0f }, target { 0.0f }, step { 0.0f };
+    int remaining { 0 };
+    int rampLength { 1 };
+};
+
+class ParameterSnapshot
+{
+public:
+    // Resolves every handle in parameterTable once; no string lookups happen after this.
+    explicit ParameterSnapshot(juce::AudioProcessorValueTreeState& apvts)
+    {
+        for (const auto& spec : parameterTable)
+        {
+            handles[(size_t) spec.index] = apvts.getRawParameterValue(spec.id);
+            jassert(handles[(size_t) spec.index] != nullptr);
+        }
+    }
+
+    // Allocates ramp storage and snaps smoothers to the current values. Not real-time safe.
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = 0.02)
+    {
+        for (const auto& spec : parameterTable)
+        {
+            const auto i = (size_t) spec.index;
+            values[i] = load(spec.index);
+            if (spec.smoothing == ParameterSpec::Smoothing::none)
+                continue;
+
+            ramps[i].assign((size_t) juce::jmax(1, maxBlockSize), 0.0f);
+            smoothers[i].setRampLength((int) (sampleRate * rampSeconds));
+            smoothers[i].reset(toSmoothedDomain(spec, values[i]));
+        }
+    }
+
+    // Audio thread: reads every parameter once and generates this block's ramps.
+    void update(int numSamples)
+    {
+        for (const auto& spec : parameterTable)
+        {
+            const auto i = (size_t) spec.index;
+            values[i] = load(spec.index);
+            if (spec.smoothing == ParameterSpec::Smoothing::none || ramps[i].empty())
+                continue;
+
+            jassert(numSamples <= (int) ramps[i].size());
+            smoothers[i].setTarget(toSmoothedDomain(spec, values[i]));
+            smoothers[i].fill(ramps[i].data(), juce::jmin(numSamples, (int) ramps[i].size()));
+        }
+    }
+
+    // Unsmoothed plain value as of the last update().
+    float get(ParamIndex index) const { return values[(size_t) index]; }
+    bool getBool(ParamIndex index) const { return get(index) > 0.5f; }
+    int getChoice(ParamIndex index) const { return juce::roundToInt(get(index)); }
+
+    // Any thread: the parameter's live value rather than the audio thread's last snapshot
+    float getCurrent(ParamIndex index) const { return load(index); }
+
+    // Per-sample values for the last update()'s block (in the smoothed domain, e.g. linear gain).
+    const float* getRamp(ParamIndex index) const { return ramps[(size_t) index].data(); }
+    bool isSmoothing(ParamIndex index) const { return smoothers[(size_t) index].isSmoothing(); }
+
+private:
+    std::array<std::atomic<float>*, numAutomatableParameters> handles {};
+    std::array<float, numAutomatableParameters> values {};
+    std::array<LinearRamp, numAutomatableParameters> smoothers;
+    std::array<std::vector<float>, numAutomatableParameters> ramps;
+
+    float load(ParamIndex index) const
+    {
+        auto* h = handles[(size_t) index];
+        return h != nullptr ? h->load(std::memory_order_relaxed) : getParameterSpec(index).defaultValue;
+    }
+
+    static float toSmoothedDomain(const ParameterSpec& spec, float value)
+    {
+        return spec.smoothing == ParameterSpec::Smoothing::decibelsToGain ? FastMath::decibelsToGain(value) : value;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterSnapshot)
+};
@@ -0,0 +1,41 @@
+// TitanVocal - Proprietary Processing Stage Identifiers
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ProcessingStage.h
+// Description: Named stages of processBlock, shared by diagnostics that attribute work per stage.
+#pragma once
+
+enum class ProcessingStage : int
+{
+    setup = 0,      // parameter reads, filter/coefficient updates, AI result collection
+    analyzerPush,
+    pitch,
+    formant,
+    gate,           // envelope detection and lookahead delay
+    aiPush,
+    aiPop,
+    mix,            // fused gate gain, saturation, dry/wet and output gain
+    spectrum,
+    numStages
+};
+
+constexpr int numProcessingStages = (int) ProcessingStage::numStages;
+
+inline const char* getProcessingStageName(ProcessingStage stage)
+{
+    switch (stage)
+    {
+        case ProcessingStage::setup:        return "setup";
+        case ProcessingStage::analyzerPush: return "analyzer push";
+        case ProcessingStage::pitch:        return "pitch";
+        case ProcessingStage::formant:      return "formant";
+        case ProcessingStage::gate:         return "gate";
+        case ProcessingStage::aiPush:       return "AI push";
+        case ProcessingStage::aiPop:        return "AI pop";
+        case ProcessingStage::mix:          return "mix";
+        case ProcessingStage::spectrum:     return "spectrum";
+        case ProcessingStage::numStages:    break;
+    }
+    return "unknown";
+}
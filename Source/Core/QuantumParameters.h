@@ -10,6 +10,73 @@
 #include <map>
 #include <string>
 
+// Host-automatable parameters. This table is the single source of truth for the APVTS layout,
+// the processor's cached parameter handles and the preset file format.
+enum class ParamIndex : int
+{
+    dryWet = 0,
+    outputGain,
+    pitchAmount,
+    pitchSpeed,
+    formantShift,
+    noiseAmount,
+    saturation,
+    aiEnabled,
+    aiModelType,
+    latencyMode,
+    count
+};
+
+constexpr int numAutomatableParameters = (int) ParamIndex::count;
+
+struct ParameterSpec
+{
+    enum class Kind { continuous, toggle, choice };
+    enum class Smoothing { none, linear, decibelsToGain }; // how the per-sample ramp is generated
+
+    ParamIndex index;
+    const char* id;
+    const char* name;
+    Kind kind;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    Smoothing smoothing;
+    bool savedInPreset;
+};
+
+constexpr const char* aiModelChoiceNames[] = {
+    "Noise Reduction", "Pitch Correction", "Formant Repair", "Breath Control", "Voice Morphing", "Timing Correction"
+};
+
+// Order matches the latencyMode choice index
+enum class LatencyMode : int
+{
+    zeroLatency = 0,    // DSP only, nothing delayed: live monitoring
+    lowLatency,         // short AI frames
+    highQuality         // long AI frames
+};
+
+constexpr const char* latencyModeChoiceNames[] = { "Zero Latency", "Low Latency", "High Quality" };
+
+constexpr ParameterSpec parameterTable[] = {
+    { ParamIndex::dryWet,       "dryWet",       "Dry/Wet",         ParameterSpec::Kind::continuous,   0.0f,  1.0f, 1.0f, ParameterSpec::Smoothing::linear,         true },
+    { ParamIndex::outputGain,   "outputGain",   "Output Gain",     ParameterSpec::Kind::continuous, -24.0f, 24.0f, 0.0f, ParameterSpec::Smoothing::decibelsToGain, true },
+    { ParamIndex::pitchAmount,  "pitchAmount",  "Pitch Amount",    ParameterSpec::Kind::continuous,   0.0f,  1.0f, 0.5f, ParameterSpec::Smoothing::none,           true },
+    { ParamIndex::pitchSpeed,   "pitchSpeed",   "Pitch Speed",     ParameterSpec::Kind::continuous,   0.0f,  1.0f, 0.5f, ParameterSpec::Smoothing::none,           true },
+    { ParamIndex::formantShift, "formantShift", "Formant Shift",   ParameterSpec::Kind::continuous, -12.0f, 12.0f, 0.0f, ParameterSpec::Smoothing::none,           true },
+    { ParamIndex::noiseAmount,  "noiseAmount",  "Noise Reduction", ParameterSpec::Kind::continuous,   0.0f,  1.0f, 0.0f, ParameterSpec::Smoothing::none,           true },
+    { ParamIndex::saturation,   "saturation",   "Saturation",      ParameterSpec::Kind::continuous,   0.0f,  1.0f, 0.0f, ParameterSpec::Smoothing::linear,         true },
+    { ParamIndex::aiEnabled,    "aiEnabled",    "AI Enabled",      ParameterSpec::Kind::toggle,       0.0f,  1.0f, 0.0f, ParameterSpec::Smoothing::none,           true },
+    { ParamIndex::aiModelType,  "aiModelType",  "AI Model",        ParameterSpec::Kind::choice,       0.0f,  5.0f, 0.0f, ParameterSpec::Smoothing::none,           false },
+    { ParamIndex::latencyMode,  "latencyMode",  "Latency Mode",    ParameterSpec::Kind::choice,       0.0f,  2.0f, 2.0f, ParameterSpec::Smoothing::none,           false },
+};
+
+static_assert(sizeof(parameterTable) / sizeof(parameterTable[0]) == (size_t) numAutomatableParameters,
+              "parameterTable must list every ParamIndex");
+
+constexpr const ParameterSpec& getParameterSpec(ParamIndex index) { return parameterTable[(int) index]; }
+
 struct QuantumParameters
 {
     // Pitch Correction Parameters
@@ -0,0 +1,376 @@
+// TitanVocal - Proprietary Real-time Safety Sanitizer Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: RealtimeSanitizer.cpp
+// Description: Interposes allocation and lock entry points and reports calls made on a real-time thread.
+//
+// This translation unit replaces global allocation functions, so it must only be linked into the
+// headless sanitizer driver, never into the plugin.
+#include "RealtimeSanitizer.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <pthread.h>
+ #include <unistd.h>
+ #define TITANVOCAL_RT_POSIX 1
+#else
+ #define TITANVOCAL_RT_POSIX 0
+#endif
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void  __libc_free(void*);
+extern "C" void* __libc_memalign(size_t, size_t);
+ #define TITANVOCAL_RAW_MALLOC          __libc_malloc
+ #define TITANVOCAL_RAW_FREE            __libc_free
+ #define TITANVOCAL_RAW_ALIGNED(a, n)   __libc_memalign(a, n)
+ #define TITANVOCAL_RAW_ALIGNED_FREE    __libc_free
+#elif defined(_MSC_VER)
+ #include <malloc.h>
+ #define TITANVOCAL_RAW_MALLOC          std::malloc
+ #define TITANVOCAL_RAW_FREE            std::free
+ #define TITANVOCAL_RAW_ALIGNED(a, n)   _aligned_malloc(n, a)
+ #define TITANVOCAL_RAW_ALIGNED_FREE    _aligned_free
+#else
+ #define TITANVOCAL_RAW_MALLOC          std::malloc
+ #define TITANVOCAL_RAW_FREE            std::free
+ #define TITANVOCAL_RAW_ALIGNED(a, n)   std::aligned_alloc(a, ((n) + (a) - 1) / (a) * (a))
+ #define TITANVOCAL_RAW_ALIGNED_FREE    std::free
+#endif
+
+namespace
+{
+    thread_local int realtimeDepth = 0;
+    thread_local bool insideReport = false;
+    thread_local ProcessingStage currentStage = ProcessingStage::setup;
+
+    std::atomic<int> violationCounts[numProcessingStages] {};
+    std::atomic<bool> printStackTraces { true };
+
+    void writeToStderr(const char* text)
+    {
+       #if TITANVOCAL_RT_POSIX
+        auto ignored = ::write(2, text, std::strlen(text));
+        (void) ignored;
+       #else
+        (void) text;
+       #endif
+    }
+
+    void reportViolation(const char* what)
+    {
+        if (realtimeDepth == 0 || insideReport)
+            return;
+
+        // Reporting may itself allocate (backtrace loads libgcc); don't count that
+        insideReport = true;
+        violationCounts[(int) currentStage].fetch_add(1, std::memory_order_relaxed);
+
+        if (printStackTraces.load(std::memory_order_relaxed))
+        {
+            writeToStderr("[TitanVocal RT] ");
+            writeToStderr(what);
+            writeToStderr(" on the audio thread in stage '");
+            writeToStderr(getProcessingStageName(currentStage));
+            writeToStderr("'\n");
+           #if TITANVOCAL_RT_POSIX
+            void* frames[48];
+            const int numFrames = backtrace(frames, 48);
+            backtrace_symbols_fd(frames, numFrames, 2);
+           #endif
+        }
+        insideReport = false;
+    }
+
+    void* allocateAligned(size_t size, std::align_val_t alignment, const char* what)
+    {
+        reportViolation(what);
+        return TITANVOCAL_RAW_ALIGNED((size_t) alignment, size == 0 ? 1 : size);
+    }
+
+    void freeAligned(void* p, const char* what)
+    {
+        if (p != nullptr) reportViolation(what);
+        TITANVOCAL_RAW_ALIGNED_FREE(p);
+    }
+
+   #if TITANVOCAL_RT_POSIX
+    // The libc entry point an interposed function forwards to, looked up once
+    template <typename Fn>
+    struct RealFunction
+    {
+        constexpr explicit RealFunction(const char* symbolName) : name(symbolName) {}
+
+        Fn get()
+        {
+            auto fn = resolved.load(std::memory_order_acquire);
+            if (fn == nullptr)
+            {
+                fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+                resolved.store(fn, std::memory_order_release);
+            }
+            return fn;
+        }
+
+        const char* name;
+        std::atomic<Fn> resolved { nullptr };
+    };
+
+    using MutexFn = int (*)(pthread_mutex_t*);
+    using MutexTimedFn = int (*)(pthread_mutex_t*, const struct timespec*);
+    using RwLockFn = int (*)(pthread_rwlock_t*);
+    using RwLockTimedFn = int (*)(pthread_rwlock_t*, const struct timespec*);
+
+    // Constant-initialized, so calls made before static construction still find the names
+    RealFunction<MutexFn> realMutexLock { "pthread_mutex_lock" };
+    RealFunction<MutexFn> realMutexTryLock { "pthread_mutex_trylock" };
+    RealFunction<MutexTimedFn> realMutexTimedLock { "pthread_mutex_timedlock" };
+    RealFunction<RwLockFn> realRwLockRead { "pthread_rwlock_rdlock" };
+    RealFunction<RwLockFn> realRwLockTryRead { "pthread_rwlock_tryrdlock" };
+    RealFunction<RwLockTimedFn> realRwLockTimedRead { "pthread_rwlock_timedrdlock" };
+    RealFunction<RwLockFn> realRwLockWrite { "pthread_rwlock_wrlock" };
+    RealFunction<RwLockFn> realRwLockTryWrite { "pthread_rwlock_trywrlock" };
+    RealFunction<RwLockTimedFn> realRwLockTimedWrite { "pthread_rwlock_timedwrlock" };
+
+    // Resolve before any real-time thread can race to do it
+    const bool lockFunctionsResolved = realMutexLock.get() != nullptr && realMutexTryLock.get() != nullptr
+                                    && realMutexTimedLock.get() != nullptr && realRwLockRead.get() != nullptr
+                                    && realRwLockTryRead.get() != nullptr && realRwLockTimedRead.get() != nullptr
+                                    && realRwLockWrite.get() != nullptr && realRwLockTryWrite.get() != nullptr
+                                    && realRwLockTimedWrite.get() != nullptr;
+   #endif
+}
+
+namespace RealtimeSanitizer
+{
+    ScopedRealtimeContext::ScopedRealtimeContext()
+    {
+        if (realtimeDepth++ == 0)
+            currentStage = ProcessingStage::setup;
+    }
+
+    ScopedRealtimeContext::~ScopedRealtimeContext() { --realtimeDepth; }
+
+    void setStage(ProcessingStage stage) { currentStage = stage; }
+
+    int getViolationCount(ProcessingStage stage)
+    {
+        return violationCounts[(int) stage].load(std::memory_order_relaxed);
+    }
+
+    int getTotalViolationCount()
+    {
+        int total = 0;
+        for (auto& count : violationCounts)
+            total += count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    void resetViolationCounts()
+    {
+        for (auto& count : violationCounts)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    void setPrintStackTraces(bool shouldPrint) { printStackTraces.store(shouldPrint); }
+}
+
+//==============================================================================
+// C++ allocation
+void* operator new(size_t size)
+{
+    reportViolation("operator new");
+    if (auto* p = TITANVOCAL_RAW_MALLOC(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    reportViolation("operator new[]");
+    if (auto* p = TITANVOCAL_RAW_MALLOC(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    reportViolation("operator new");
+    return TITANVOCAL_RAW_MALLOC(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    reportViolation("operator new[]");
+    return TITANVOCAL_RAW_MALLOC(size == 0 ? 1 : size);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr) reportViolation("operator delete");
+    TITANVOCAL_RAW_FREE(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    if (p != nullptr) reportViolation("operator delete[]");
+    TITANVOCAL_RAW_FREE(p);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete[](p); }
+
+// Over-aligned types (alignas above the default new alignment)
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (auto* p = allocateAligned(size, alignment, "aligned operator new"))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    if (auto* p = allocateAligned(size, alignment, "aligned operator new[]"))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment, "aligned operator new");
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment, "aligned operator new[]");
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { freeAligned(p, "aligned operator delete"); }
+void operator delete[](void* p, std::align_val_t) noexcept { freeAligned(p, "aligned operator delete[]"); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { freeAligned(p, "aligned operator delete"); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { freeAligned(p, "aligned operator delete[]"); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p, "aligned operator delete"); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p, "aligned operator delete[]"); }
+
+//==============================================================================
+// C allocation and locking (glibc / POSIX only)
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        reportViolation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        reportViolation("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* p, size_t size)
+    {
+        reportViolation("realloc");
+        return __libc_realloc(p, size);
+    }
+
+    void free(void* p)
+    {
+        if (p != nullptr) reportViolation("free");
+        __libc_free(p);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size)
+    {
+        reportViolation("posix_memalign");
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        reportViolation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        reportViolation("memalign");
+        return __libc_memalign(alignment, size);
+    }
+}
+#endif
+
+#if TITANVOCAL_RT_POSIX
+extern "C"
+{
+    // Every way of taking a mutex or rwlock counts: a try-lock that fails on the audio thread
+    // still means the data is shared with a thread that can hold it for any length of time
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        reportViolation("pthread_mutex_lock");
+        return realMutexLock.get()(mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* mutex)
+    {
+        reportViolation("pthread_mutex_trylock");
+        return realMutexTryLock.get()(mutex);
+    }
+
+    int pthread_mutex_timedlock(pthread_mutex_t* mutex, const struct timespec* timeout)
+    {
+        reportViolation("pthread_mutex_timedlock");
+        return realMutexTimedLock.get()(mutex, timeout);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_rdlock");
+        return realRwLockRead.get()(lock);
+    }
+
+    int pthread_rwlock_tryrdlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_tryrdlock");
+        return realRwLockTryRead.get()(lock);
+    }
+
+    int pthread_rwlock_timedrdlock(pthread_rwlock_t* lock, const struct timespec* timeout)
+    {
+        reportViolation("pthread_rwlock_timedrdlock");
+        return realRwLockTimedRead.get()(lock, timeout);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_wrlock");
+        return realRwLockWrite.get()(lock);
+    }
+
+    int pthread_rwlock_trywrlock(pthread_rwlock_t* lock)
+    {
+        reportViolation("pthread_rwlock_trywrlock");
+        return realRwLockTryWrite.get()(lock);
+    }
+
+    int pthread_rwlock_timedwrlock(pthread_rwlock_t* lock, const struct timespec* timeout)
+    {
+        reportViolation("pthread_rwlock_timedwrlock");
+        return realRwLockTimedWrite.get()(lock, timeout);
+    }
+}
+#endif
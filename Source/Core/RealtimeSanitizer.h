@@ -0,0 +1,43 @@
+// TitanVocal - Proprietary Real-time Safety Sanitizer
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: RealtimeSanitizer.h
+// Description: Flags heap and mutex use made while the current thread is inside processBlock.
+#pragma once
+
+#include "ProcessingStage.h"
+
+// Built only into the headless TitanVocal_RtCheck driver (CMake option TITANVOCAL_RT_SANITIZER).
+// In every other build the macros below compile to nothing.
+#ifndef TITANVOCAL_RT_SANITIZER
+ #define TITANVOCAL_RT_SANITIZER 0
+#endif
+
+namespace RealtimeSanitizer
+{
+    // Marks the current thread as real-time for the lifetime of the object.
+    struct ScopedRealtimeContext
+    {
+        ScopedRealtimeContext();
+        ~ScopedRealtimeContext();
+    };
+
+    // Attributes subsequent violations on this thread to the given stage.
+    void setStage(ProcessingStage stage);
+
+    int getViolationCount(ProcessingStage stage);
+    int getTotalViolationCount();
+    void resetViolationCounts();
+
+    // When false, violations are counted but no stack trace is printed.
+    void setPrintStackTraces(bool shouldPrint);
+}
+
+#if TITANVOCAL_RT_SANITIZER
+ #define TITANVOCAL_RT_SCOPE()       RealtimeSanitizer::ScopedRealtimeContext titanRealtimeScope
+ #define TITANVOCAL_RT_STAGE(stage)  RealtimeSanitizer::setStage(stage)
+#else
+ #define TITANVOCAL_RT_SCOPE()
+ #define TITANVOCAL_RT_STAGE(stage)
+#endif
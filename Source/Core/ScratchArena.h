@@ -0,0 +1,65 @@
+// TitanVocal - Proprietary Scratch Arena
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: ScratchArena.h
+// Description: Per-instance bump allocator for audio-thread scratch memory, reset once per block.
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+class ScratchArena
+{
+public:
+    static constexpr size_t alignment = 64; // cache line, also enough for AVX loads
+
+    ScratchArena() = default;
+
+    // Reserves capacity bytes. Not real-time safe: call from prepareToPlay.
+    void prepare(size_t capacityBytes)
+    {
+        storage.assign(capacityBytes + alignment, 0);
+        const auto base = reinterpret_cast<std::uintptr_t>(storage.data());
+        offsetToAligned = (size_t) ((alignment - (base % alignment)) % alignment);
+        capacity = capacityBytes;
+        used = 0;
+    }
+
+    // Bytes needed to hold count elements of T, including alignment padding.
+    template <typename T>
+    static constexpr size_t bytesFor(size_t count)
+    {
+        return ((count * sizeof(T) + alignment - 1) / alignment) * alignment;
+    }
+
+    // Releases everything handed out since the last reset. Call at the top of each block.
+    void reset() { used = 0; }
+
+    // Returns uninitialised, aligned storage for count elements, or nullptr if the arena is exhausted.
+    template <typename T>
+    T* allocate(size_t count)
+    {
+        const size_t bytes = bytesFor<T>(count);
+        if (used + bytes > capacity)
+        {
+            jassertfalse; // arena was sized too small in prepareToPlay
+            return nullptr;
+        }
+
+        auto* ptr = storage.data() + offsetToAligned + used;
+        used += bytes;
+        return reinterpret_cast<T*>(ptr);
+    }
+
+    size_t getBytesUsed() const { return used; }
+    size_t getCapacity() const { return capacity; }
+
+private:
+    std::vector<juce::uint8> storage;
+    size_t offsetToAligned { 0 };
+    size_t capacity { 0 };
+    size_t used { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(ScratchArena)
+};
@@ -0,0 +1,130 @@
+// TitanVocal - Proprietary Lock-Free Ring Buffer
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: SpscRingBuffer.h
+// Description: Preallocated, power-of-two, wait-free single-producer/single-consumer ring buffer.
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+// One thread writes, one thread reads; neither ever blocks or allocates once prepare() has run.
+// Read/write positions are free-running counters masked into the storage, so the full capacity
+// is usable and "empty" vs "full" never needs a spare slot.
+template <typename SampleType>
+class SpscRingBuffer
+{
+public:
+    SpscRingBuffer() = default;
+
+    // Allocates storage for at least minCapacity elements (rounded up to a power of two).
+    // Not real-time safe: call from prepareToPlay or another non-audio context.
+    void prepare(int minCapacity)
+    {
+        const int capacity = juce::nextPowerOfTwo(juce::jmax(2, minCapacity));
+        storage.assign((size_t) capacity, SampleType {});
+        mask = (size_t) capacity - 1;
+        reset();
+    }
+
+    // Discards all contents. Only safe while neither side is running.
+    void reset()
+    {
+        writePos.store(0, std::memory_order_relaxed);
+        readPos.store(0, std::memory_order_relaxed);
+    }
+
+    int getCapacity() const { return (int) storage.size(); }
+
+    int getNumReady() const
+    {
+        const auto w = writePos.load(std::memory_order_acquire);
+        const auto r = readPos.load(std::memory_order_acquire);
+        return (int) (w - r);
+    }
+
+    int getFreeSpace() const { return getCapacity() - getNumReady(); }
+
+    // Producer side. Writes up to numItems and returns how many were accepted.
+    int write(const SampleType* source, int numItems)
+    {
+        const auto w = writePos.load(std::memory_order_relaxed);
+        const auto r = readPos.load(std::memory_order_acquire);
+        const int toWrite = juce::jmin(numItems, getCapacity() - (int) (w - r));
+        if (toWrite <= 0)
+            return 0;
+
+        const size_t start = w & mask;
+        const size_t first = juce::jmin((size_t) toWrite, storage.size() - start);
+        std::copy(source, source + first, storage.data() + start);
+        std::copy(source + first, source + toWrite, storage.data());
+
+        writePos.store(w + (size_t) toWrite, std::memory_order_release);
+        return toWrite;
+    }
+
+    // Producer side. Writes numItems copies of value (used for priming latency with silence).
+    int fill(SampleType value, int numItems)
+    {
+        const auto w = writePos.load(std::memory_order_relaxed);
+        const auto r = readPos.load(std::memory_order_acquire);
+        const int toWrite = juce::jmin(numItems, getCapacity() - (int) (w - r));
+        if (toWrite <= 0)
+            return 0;
+
+        for (int i = 0; i < toWrite; ++i)
+            storage[(w + (size_t) i) & mask] = value;
+
+        writePos.store(w + (size_t) toWrite, std::memory_order_release);
+        return toWrite;
+    }
+
+    // Consumer side. Reads up to numItems into dest and returns how many were read.
+    int read(SampleType* dest, int numItems)
+    {
+        const int toRead = peek(dest, numItems);
+        discard(toRead);
+        return toRead;
+    }
+
+    // Consumer side. Copies up to numItems without consuming them.
+    int peek(SampleType* dest, int numItems) const
+    {
+        const auto r = readPos.load(std::memory_order_relaxed);
+        const auto w = writePos.load(std::memory_order_acquire);
+        const int toRead = juce::jmin(numItems, (int) (w - r));
+        if (toRead <= 0)
+            return 0;
+
+        const size_t start = r & mask;
+        const size_t first = juce::jmin((size_t) toRead, storage.size() - start);
+        std::copy(storage.data() + start, storage.data() + start + first, dest);
+        std::copy(storage.data(), storage.data() + (toRead - first), dest + first);
+        return toRead;
+    }
+
+    // Consumer side. Drops up to numItems and returns how many were dropped.
+    int discard(int numItems)
+    {
+        const auto r = readPos.load(std::memory_order_relaxed);
+        const auto w = writePos.load(std::memory_order_acquire);
+        const int toDrop = juce::jmin(numItems, (int) (w - r));
+        if (toDrop <= 0)
+            return 0;
+
+        readPos.store(r + (size_t) toDrop, std::memory_order_release);
+        return toDrop;
+    }
+
+private:
+    std::vector<SampleType> storage;
+    size_t mask { 0 };
+
+    // Kept on separate cache lines so producer and consumer don't false-share.
+    alignas(64) std::atomic<size_t> writePos { 0 };
+    alignas(64) std::atomic<size_t> readPos { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(SpscRingBuffer)
+};
@@ -0,0 +1,101 @@
+// TitanVocal - Proprietary Stage Telemetry
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: StageTelemetry.h
+// Description: Per-stage processBlock timings, handed to the editor through a lock-free ring.
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "ProcessingStage.h"
+#include "SpscRingBuffer.h"
+
+// The audio thread marks stage boundaries with the monotonic high-resolution clock (a vDSO /
+// QueryPerformanceCounter read, tens of nanoseconds). Time between two marks is charged to the
+// earlier stage. Work measured elsewhere, for example on channel pool workers, is added as CPU
+// time, so parallel stages can add up to more than the block's wall time. One record per block
+// goes into the ring. If the editor is closed or falls behind, records are dropped, never waited on.
+class StageTelemetry
+{
+public:
+    struct BlockTimings
+    {
+        std::array<float, numProcessingStages> stageMicros {};
+        float blockMicros = 0.0f;   // wall time from beginBlock to endBlock
+        float budgetMicros = 0.0f;  // duration of the block's audio
+    };
+
+    StageTelemetry() = default;
+
+    // Not real-time safe: sizes the ring for about a second of small blocks.
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        microsPerTick = 1.0e6 / (double) juce::Time::getHighResolutionTicksPerSecond();
+        ring.prepare(2048);
+    }
+
+    static juce::int64 now() { return juce::Time::getHighResolutionTicks(); }
+
+    // Audio thread
+    void beginBlock(int numSamples)
+    {
+        stageTicks.fill(0);
+        blockStart = stageStart = now();
+        currentStage = ProcessingStage::setup;
+        budgetMicros = (float) (1.0e6 * numSamples / sampleRate);
+    }
+
+    // Closes the running stage (if any) and starts timing stage
+    void mark(ProcessingStage stage)
+    {
+        const auto t = now();
+        close(t);
+        currentStage = stage;
+        stageStart = t;
+    }
+
+    // Closes the running stage without starting another, e.g. while other threads are timing
+    void suspend()
+    {
+        close(now());
+        currentStage = ProcessingStage::numStages;
+    }
+
+    void add(ProcessingStage stage, juce::int64 ticks) { stageTicks[(size_t) stage] += ticks; }
+
+    void endBlock()
+    {
+        const auto t = now();
+        close(t);
+        currentStage = ProcessingStage::numStages;
+
+        BlockTimings timings;
+        for (size_t s = 0; s < stageTicks.size(); ++s)
+            timings.stageMicros[s] = (float) ((double) stageTicks[s] * microsPerTick);
+        timings.blockMicros = (float) ((double) (t - blockStart) * microsPerTick);
+        timings.budgetMicros = budgetMicros;
+        ring.write(&timings, 1);
+    }
+
+    // Reader thread (the editor's timer): returns how many records were copied to dest.
+    int read(BlockTimings* dest, int maxRecords) { return ring.read(dest, maxRecords); }
+
+private:
+    SpscRingBuffer<BlockTimings> ring;
+    std::array<juce::int64, numProcessingStages> stageTicks {};
+    juce::int64 blockStart { 0 }, stageStart { 0 };
+    ProcessingStage currentStage { ProcessingStage::numStages };
+    double sampleRate { 44100.0 };
+    double microsPerTick { 1.0 };
+    float budgetMicros { 0.0f };
+
+    void close(juce::int64 t)
+    {
+        if (currentStage != ProcessingStage::numStages)
+            stageTicks[(size_t) currentStage] += t - stageStart;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(StageTelemetry)
+};
@@ -0,0 +1,62 @@
+// TitanVocal - Proprietary Wake-up Semaphore
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: WakeSemaphore.h
+// Description: Counting semaphore the audio thread can post to without taking a lock.
+#pragma once
+
+#include <JuceHeader.h>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#else
+ #include <cerrno>
+ #include <ctime>
+ #include <semaphore.h>
+#endif
+
+// juce::WaitableEvent takes a mutex to signal; post() here is a single futex/kernel wake. Pulls in
+// the platform headers, so include it from .cpp files only.
+class WakeSemaphore
+{
+public:
+   #if JUCE_WINDOWS
+    WakeSemaphore()  { handle = CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr); }
+    ~WakeSemaphore() { CloseHandle(handle); }
+    void post(int count = 1) { ReleaseSemaphore(handle, count, nullptr); }
+    void waitFor(int milliseconds) { WaitForSingleObject(handle, (DWORD) milliseconds); }
+   #elif JUCE_MAC || JUCE_IOS
+    WakeSemaphore()  { handle = dispatch_semaphore_create(0); }
+    ~WakeSemaphore() { dispatch_release(handle); }
+    void post(int count = 1) { while (--count >= 0) dispatch_semaphore_signal(handle); }
+    void waitFor(int milliseconds) { dispatch_semaphore_wait(handle, dispatch_time(DISPATCH_TIME_NOW, (int64_t) milliseconds * 1000000)); }
+   #else
+    WakeSemaphore()  { sem_init(&handle, 0, 0); }
+    ~WakeSemaphore() { sem_destroy(&handle); }
+    void post(int count = 1) { while (--count >= 0) sem_post(&handle); }
+
+    void waitFor(int milliseconds)
+    {
+        timespec deadline {};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += (long) milliseconds * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        while (sem_timedwait(&handle, &deadline) != 0 && errno == EINTR) {}
+    }
+   #endif
+
+private:
+   #if JUCE_WINDOWS
+    HANDLE handle;
+   #elif JUCE_MAC || JUCE_IOS
+    dispatch_semaphore_t handle;
+   #else
+    sem_t handle;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSemaphore)
+};
@@ -0,0 +1,80 @@
+// TitanVocal - Proprietary Compensation Delay
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: CompensationDelay.h
+// Description: Whole-sample per-channel delay that lines one path up with a longer one.
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+class CompensationDelay
+{
+public:
+    CompensationDelay() = default;
+
+    // Not real-time safe: allocates one line per channel, long enough for maxDelay plus a block.
+    void prepare(int numChannels, int maxDelaySamples, int maxBlockSize)
+    {
+        maxDelay = juce::jmax(0, maxDelaySamples);
+        int size = 1;
+        while (size < maxDelay + maxBlockSize)
+            size <<= 1;
+        mask = size - 1;
+
+        lines.resize((size_t) juce::jmax(1, numChannels));
+        for (auto& line : lines)
+            line.assign((size_t) size, 0.0f);
+        delay = 0;
+        writePos = 0;
+    }
+
+    // Audio thread. A new delay restarts every line from silence.
+    void setDelay(int newDelay)
+    {
+        newDelay = juce::jlimit(0, maxDelay, newDelay);
+        if (newDelay == delay)
+            return;
+
+        delay = newDelay;
+        writePos = 0;
+        for (auto& line : lines)
+            std::fill(line.begin(), line.end(), 0.0f);
+    }
+
+    int getDelay() const { return delay; }
+
+    // Returns input itself when there is no delay, otherwise output holding the delayed input.
+    // Channels are independent, so different threads may process different channels. Call
+    // advance() once per block after every channel has been processed.
+    const float* process(int channel, const float* input, float* output, int numSamples)
+    {
+        if (delay == 0)
+            return input;
+
+        jassert(channel < (int) lines.size() && numSamples + delay <= mask + 1);
+        auto& line = lines[(size_t) channel];
+        for (int i = 0; i < numSamples; ++i)
+        {
+            line[(size_t) ((writePos + i) & mask)] = input[i];
+            output[i] = line[(size_t) ((writePos + i - delay) & mask)];
+        }
+        return output;
+    }
+
+    void advance(int numSamples)
+    {
+        if (delay > 0)
+            writePos = (writePos + numSamples) & mask;
+    }
+
+private:
+    std::vector<std::vector<float>> lines;
+    int maxDelay { 0 };
+    int delay { 0 };
+    int writePos { 0 };
+    int mask { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(CompensationDelay)
+};
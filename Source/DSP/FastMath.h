@@ -0,0 +1,306 @@
+// TitanVocal - Proprietary Fast Math
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: FastMath.h
+// Description: Polynomial/rational approximations of tanh, exp2, log2 and dB conversions, scalar and SIMD.
+//
+// Each function is written once against a small "ops" interface and instantiated for plain floats and
+// for the widest vector unit the build targets (AVX2+FMA, SSE2 or AArch64 NEON). Compilers won't
+// reliably vectorise the scalar forms inside a loop, so hot loops use the array forms or build on the
+// simd ops directly. Error bounds are checked by Tools/FastMathCheckMain.cpp. No JUCE dependency.
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) && defined(__FMA__)
+ #include <immintrin.h>
+ #define TITANVOCAL_FASTMATH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define TITANVOCAL_FASTMATH_SSE2 1
+#elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define TITANVOCAL_FASTMATH_NEON 1
+#endif
+
+namespace FastMath
+{
+// Ops layer and templated kernels, also the building blocks for other vectorised kernels
+namespace simd
+{
+    struct ScalarOps
+    {
+        using Float = float;
+        using Int = int32_t;
+        static constexpr int width = 1;
+
+        static Float load(const float* p) { return *p; }
+        static void store(float* p, Float v) { *p = v; }
+        static Float set(float v) { return v; }
+        static Float add(Float a, Float b) { return a + b; }
+        static Float sub(Float a, Float b) { return a - b; }
+        static Float mul(Float a, Float b) { return a * b; }
+        static Float div(Float a, Float b) { return a / b; }
+        static Float mulAdd(Float a, Float b, Float c) { return a * b + c; }
+        static Float min(Float a, Float b) { return a < b ? a : b; }
+        static Float max(Float a, Float b) { return a > b ? a : b; }
+        static Float abs(Float a) { return std::abs(a); }
+        static Float keepIfGreater(Float v, Float a, Float b) { return a > b ? v : 0.0f; }
+        static Int roundToInt(Float a) { return (Int) std::lrint(a); }
+        static Float toFloat(Int i) { return (Float) i; }
+
+        static Float pow2i(Int i)
+        {
+            const auto bits = (uint32_t) (i + 127) << 23;
+            Float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        static Int exponentOf(Float x)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return (Int) (bits >> 23) - 127;
+        }
+
+        static Float mantissaOf(Float x)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            bits = (bits & 0x007fffffu) | 0x3f800000u;
+            Float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+    };
+
+   #if TITANVOCAL_FASTMATH_AVX2
+    struct Avx2Ops
+    {
+        using Float = __m256;
+        using Int = __m256i;
+        static constexpr int width = 8;
+
+        static Float load(const float* p) { return _mm256_loadu_ps(p); }
+        static void store(float* p, Float v) { _mm256_storeu_ps(p, v); }
+        static Float set(float v) { return _mm256_set1_ps(v); }
+        static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        static Float div(Float a, Float b) { return _mm256_div_ps(a, b); }
+        static Float mulAdd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+        static Float min(Float a, Float b) { return _mm256_min_ps(a, b); }
+        static Float max(Float a, Float b) { return _mm256_max_ps(a, b); }
+        static Float abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        static Float keepIfGreater(Float v, Float a, Float b) { return _mm256_and_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ), v); }
+        static Int roundToInt(Float a) { return _mm256_cvtps_epi32(a); }
+        static Float toFloat(Int i) { return _mm256_cvtepi32_ps(i); }
+        static Float pow2i(Int i) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(i, _mm256_set1_epi32(127)), 23)); }
+        static Int exponentOf(Float x) { return _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), _mm256_set1_epi32(127)); }
+
+        static Float mantissaOf(Float x)
+        {
+            const auto bits = _mm256_and_si256(_mm256_castps_si256(x), _mm256_set1_epi32(0x007fffff));
+            return _mm256_castsi256_ps(_mm256_or_si256(bits, _mm256_set1_epi32(0x3f800000)));
+        }
+    };
+    using VectorOps = Avx2Ops;
+   #elif TITANVOCAL_FASTMATH_SSE2
+    struct Sse2Ops
+    {
+        using Float = __m128;
+        using Int = __m128i;
+        static constexpr int width = 4;
+
+        static Float load(const float* p) { return _mm_loadu_ps(p); }
+        static void store(float* p, Float v) { _mm_storeu_ps(p, v); }
+        static Float set(float v) { return _mm_set1_ps(v); }
+        static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+        static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+        static Float div(Float a, Float b) { return _mm_div_ps(a, b); }
+        static Float mulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+        static Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+        static Float abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        static Float keepIfGreater(Float v, Float a, Float b) { return _mm_and_ps(_mm_cmpgt_ps(a, b), v); }
+        static Int roundToInt(Float a) { return _mm_cvtps_epi32(a); }
+        static Float toFloat(Int i) { return _mm_cvtepi32_ps(i); }
+        static Float pow2i(Int i) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(i, _mm_set1_epi32(127)), 23)); }
+        static Int exponentOf(Float x) { return _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(127)); }
+
+        static Float mantissaOf(Float x)
+        {
+            const auto bits = _mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(0x007fffff));
+            return _mm_castsi128_ps(_mm_or_si128(bits, _mm_set1_epi32(0x3f800000)));
+        }
+    };
+    using VectorOps = Sse2Ops;
+   #elif TITANVOCAL_FASTMATH_NEON
+    struct NeonOps
+    {
+        using Float = float32x4_t;
+        using Int = int32x4_t;
+        static constexpr int width = 4;
+
+        static Float load(const float* p) { return vld1q_f32(p); }
+        static void store(float* p, Float v) { vst1q_f32(p, v); }
+        static Float set(float v) { return vdupq_n_f32(v); }
+        static Float add(Float a, Float b) { return vaddq_f32(a, b); }
+        static Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+        static Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+        static Float div(Float a, Float b) { return vdivq_f32(a, b); }
+        static Float mulAdd(Float a, Float b, Float c) { return vfmaq_f32(c, a, b); }
+        static Float min(Float a, Float b) { return vminq_f32(a, b); }
+        static Float max(Float a, Float b) { return vmaxq_f32(a, b); }
+        static Float abs(Float a) { return vabsq_f32(a); }
+        static Float keepIfGreater(Float v, Float a, Float b) { return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(a, b), vreinterpretq_u32_f32(v))); }
+        static Int roundToInt(Float a) { return vcvtnq_s32_f32(a); }
+        static Float toFloat(Int i) { return vcvtq_f32_s32(i); }
+        static Float pow2i(Int i) { return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(i, vdupq_n_s32(127)), 23)); }
+        static Int exponentOf(Float x) { return vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x), 23)), vdupq_n_s32(127)); }
+
+        static Float mantissaOf(Float x)
+        {
+            const auto bits = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x007fffff));
+            return vreinterpretq_f32_u32(vorrq_u32(bits, vdupq_n_u32(0x3f800000)));
+        }
+    };
+    using VectorOps = NeonOps;
+   #else
+    using VectorOps = ScalarOps;
+   #endif
+
+    // Odd rational minimax fit on [-7.9, 7.9]; beyond that tanh is 1 to float precision
+    template <typename Ops>
+    typename Ops::Float tanh(typename Ops::Float x)
+    {
+        const float limit = 7.90531110763549805f;
+        x = Ops::max(Ops::set(-limit), Ops::min(Ops::set(limit), x));
+        const auto x2 = Ops::mul(x, x);
+
+        auto p = Ops::mulAdd(x2, Ops::set(-2.76076847742355e-16f), Ops::set(2.00018790482477e-13f));
+        p = Ops::mulAdd(x2, p, Ops::set(-8.60467152213735e-11f));
+        p = Ops::mulAdd(x2, p, Ops::set(5.12229709037114e-08f));
+        p = Ops::mulAdd(x2, p, Ops::set(1.48572235717979e-05f));
+        p = Ops::mulAdd(x2, p, Ops::set(6.37261928875436e-04f));
+        p = Ops::mulAdd(x2, p, Ops::set(4.89352455891786e-03f));
+        p = Ops::mul(x, p);
+
+        auto q = Ops::mulAdd(x2, Ops::set(1.19825839466702e-06f), Ops::set(1.18534705686654e-04f));
+        q = Ops::mulAdd(x2, q, Ops::set(2.26843463243900e-03f));
+        q = Ops::mulAdd(x2, q, Ops::set(4.89352518554385e-03f));
+        return Ops::div(p, q);
+    }
+
+    // 2^x = 2^round(x) * 2^f with f in [-0.5, 0.5]; degree-6 polynomial for 2^f (Cephes exp2f)
+    template <typename Ops>
+    typename Ops::Float exp2(typename Ops::Float x)
+    {
+        x = Ops::max(Ops::set(-126.0f), Ops::min(Ops::set(127.0f), x));
+        const auto i = Ops::roundToInt(x);
+        const auto f = Ops::sub(x, Ops::toFloat(i));
+
+        auto p = Ops::mulAdd(f, Ops::set(1.535336188319500e-4f), Ops::set(1.339887440266574e-3f));
+        p = Ops::mulAdd(f, p, Ops::set(9.618437357674640e-3f));
+        p = Ops::mulAdd(f, p, Ops::set(5.550332471162809e-2f));
+        p = Ops::mulAdd(f, p, Ops::set(2.402264791363012e-1f));
+        p = Ops::mulAdd(f, p, Ops::set(6.931472028550421e-1f));
+        p = Ops::mulAdd(f, p, Ops::set(1.0f));
+        return Ops::mul(p, Ops::pow2i(i));
+    }
+
+    // log2(x) = e + log2(m) with m in [1, 2), using the atanh series in t = (m - 1) / (m + 1), |t| <= 1/3.
+    // Inputs at or below FLT_MIN return -126.
+    template <typename Ops>
+    typename Ops::Float log2(typename Ops::Float x)
+    {
+        x = Ops::max(Ops::set(FLT_MIN), x);
+        const auto e = Ops::toFloat(Ops::exponentOf(x));
+        const auto m = Ops::mantissaOf(x);
+        const auto t = Ops::div(Ops::sub(m, Ops::set(1.0f)), Ops::add(m, Ops::set(1.0f)));
+        const auto t2 = Ops::mul(t, t);
+
+        auto s = Ops::mulAdd(t2, Ops::set(1.0f / 13.0f), Ops::set(1.0f / 11.0f));
+        s = Ops::mulAdd(t2, s, Ops::set(1.0f / 9.0f));
+        s = Ops::mulAdd(t2, s, Ops::set(1.0f / 7.0f));
+        s = Ops::mulAdd(t2, s, Ops::set(1.0f / 5.0f));
+        s = Ops::mulAdd(t2, s, Ops::set(1.0f / 3.0f));
+        s = Ops::mulAdd(t2, s, Ops::set(1.0f));
+        return Ops::mulAdd(Ops::mul(t, s), Ops::set(2.88539008177792681f), e); // 2 / ln 2
+    }
+
+    constexpr float log2Of10Over20 = 0.166096404744368118f;   // dB -> log2(gain)
+    constexpr float twentyLog10Of2 = 6.02059991327962390f;    // log2(gain) -> dB
+
+    template <typename Ops>
+    typename Ops::Float decibelsToGain(typename Ops::Float dB, float minusInfinityDb)
+    {
+        return Ops::keepIfGreater(exp2<Ops>(Ops::mul(dB, Ops::set(log2Of10Over20))), dB, Ops::set(minusInfinityDb));
+    }
+
+    template <typename Ops>
+    typename Ops::Float gainToDecibels(typename Ops::Float gain, float minusInfinityDb)
+    {
+        return Ops::max(Ops::set(minusInfinityDb), Ops::mul(log2<Ops>(gain), Ops::set(twentyLog10Of2)));
+    }
+
+    // Applies kernel(ops, x) across an array: full vectors first, then a scalar tail
+    template <typename Kernel>
+    void transform(const float* input, float* output, int numValues, Kernel kernel)
+    {
+        int i = 0;
+        for (; i + VectorOps::width <= numValues; i += VectorOps::width)
+            VectorOps::store(output + i, kernel(VectorOps{}, VectorOps::load(input + i)));
+        for (; i < numValues; ++i)
+            output[i] = kernel(ScalarOps{}, input[i]);
+    }
+}
+
+    //==============================================================================
+    // Scalar forms
+    inline float tanh(float x)  { return simd::tanh<simd::ScalarOps>(x); }
+    inline float exp2(float x)  { return simd::exp2<simd::ScalarOps>(x); }
+    inline float log2(float x)  { return simd::log2<simd::ScalarOps>(x); }
+    inline float log1p(float x) { return 0.693147180559945309f * log2(1.0f + x); }
+    inline float semitonesToRatio(float semitones) { return exp2(semitones * (1.0f / 12.0f)); }
+
+    // Same conventions as juce::Decibels: anything at or below minusInfinityDb is silence
+    inline float decibelsToGain(float dB, float minusInfinityDb = -100.0f) { return simd::decibelsToGain<simd::ScalarOps>(dB, minusInfinityDb); }
+    inline float gainToDecibels(float gain, float minusInfinityDb = -100.0f) { return simd::gainToDecibels<simd::ScalarOps>(gain, minusInfinityDb); }
+
+    //==============================================================================
+    // Array forms on the widest vector unit available to this build. Input and output may alias.
+    inline void tanh(const float* in, float* out, int n) { simd::transform(in, out, n, [](auto ops, auto x) { return simd::tanh<decltype(ops)>(x); }); }
+    inline void exp2(const float* in, float* out, int n) { simd::transform(in, out, n, [](auto ops, auto x) { return simd::exp2<decltype(ops)>(x); }); }
+    inline void log2(const float* in, float* out, int n) { simd::transform(in, out, n, [](auto ops, auto x) { return simd::log2<decltype(ops)>(x); }); }
+
+    inline void decibelsToGain(const float* in, float* out, int n, float minusInfinityDb = -100.0f)
+    {
+        simd::transform(in, out, n, [minusInfinityDb](auto ops, auto x) { return simd::decibelsToGain<decltype(ops)>(x, minusInfinityDb); });
+    }
+
+    inline void gainToDecibels(const float* in, float* out, int n, float minusInfinityDb = -100.0f)
+    {
+        simd::transform(in, out, n, [minusInfinityDb](auto ops, auto x) { return simd::gainToDecibels<decltype(ops)>(x, minusInfinityDb); });
+    }
+
+    // Vector unit the array forms were compiled for
+    inline const char* getInstructionSetName()
+    {
+       #if TITANVOCAL_FASTMATH_AVX2
+        return "AVX2+FMA";
+       #elif TITANVOCAL_FASTMATH_SSE2
+        return "SSE2";
+       #elif TITANVOCAL_FASTMATH_NEON
+        return "NEON";
+       #else
+        return "scalar";
+       #endif
+    }
+}
@@ -0,0 +1,166 @@
+// TitanVocal - Proprietary Formant Filter Bank
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: FormantFilterBank.h
+// Description: Three-section peaking biquad cascade that runs channels side by side in SIMD lanes.
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "FastMath.h"
+
+class FormantFilterBank
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int numSections = 3;
+    static constexpr int lanes = (int) Vec::SIMDNumElements;
+
+    // Allocates lane state for up to maxChannels. Not real-time safe.
+    void prepare(double newSampleRate, int maxChannels)
+    {
+        sampleRate = newSampleRate;
+        groups.resize((size_t) ((juce::jmax(1, maxChannels) + lanes - 1) / lanes));
+        lastShift = std::numeric_limits<float>::quiet_NaN();
+        setShift(0.0f, 0);
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& g : groups)
+            for (int s = 0; s < numSections; ++s)
+                g.s1[s] = g.s2[s] = Vec::expand(0.0f);
+    }
+
+    // Recomputes coefficients only when the shift moved; the change is interpolated over rampSamples.
+    void setShift(float semitones, int rampSamples)
+    {
+        if (semitones == lastShift)
+            return;
+        lastShift = semitones;
+
+        const float factor = FastMath::semitonesToRatio(semitones);
+        for (int s = 0; s < numSections; ++s)
+            target[(size_t) s] = makePeak(baseFrequencies[s] * factor, q, gains[s]);
+
+        if (rampSamples <= 0)
+        {
+            current = target;
+            rampRemaining = 0;
+            return;
+        }
+
+        rampRemaining = rampSamples;
+        for (int s = 0; s < numSections; ++s)
+            for (int k = 0; k < 5; ++k)
+                step[(size_t) s].c[k] = (target[(size_t) s].c[k] - current[(size_t) s].c[k]) / (float) rampSamples;
+    }
+
+    // Filters numChannels buffers in place, lanes channels at a time.
+    void process(float* const* channels, int numChannels, int numSamples)
+    {
+        for (int g = 0; g < getNumGroups(numChannels); ++g)
+            processGroup(g, channels + g * lanes, juce::jmin(lanes, numChannels - g * lanes), numSamples);
+        advance(numSamples);
+    }
+
+    static int getNumGroups(int numChannels) { return (numChannels + lanes - 1) / lanes; }
+
+    // Filters the (up to lanes) channels of one lane group. Groups share nothing but the coefficients,
+    // so different groups may run on different threads; call advance() once they have all finished.
+    void processGroup(int group, float* const* groupChannels, int numActive, int numSamples)
+    {
+        jassert(group < (int) groups.size() && numActive <= lanes);
+        if (group >= (int) groups.size())
+            return;
+
+        const int numRamped = juce::jmin(numSamples, rampRemaining);
+        auto& state = groups[(size_t) group];
+        auto coeffs = current;
+
+        alignas(sizeof(Vec)) float frame[lanes] = {};
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (i < numRamped)
+                for (int s = 0; s < numSections; ++s)
+                    for (int k = 0; k < 5; ++k)
+                        coeffs[(size_t) s].c[k] += step[(size_t) s].c[k];
+
+            for (int l = 0; l < numActive; ++l)
+                frame[l] = groupChannels[l][i];
+
+            auto x = Vec::fromRawArray(frame);
+            for (int s = 0; s < numSections; ++s)
+            {
+                const auto& c = coeffs[(size_t) s].c;
+                // Transposed direct form II
+                const auto y = state.s1[s] + x * c[0];
+                state.s1[s] = state.s2[s] + x * c[1] - y * c[3];
+                state.s2[s] = x * c[2] - y * c[4];
+                x = y;
+            }
+            x.copyToRawArray(frame);
+
+            for (int l = 0; l < numActive; ++l)
+                groupChannels[l][i] = frame[l];
+        }
+    }
+
+    // Moves the coefficient glide on by a block
+    void advance(int numSamples)
+    {
+        const int numRamped = juce::jmin(numSamples, rampRemaining);
+        rampRemaining -= numRamped;
+        if (rampRemaining == 0)
+            current = target;
+        else
+            for (int s = 0; s < numSections; ++s)
+                for (int k = 0; k < 5; ++k)
+                    current[(size_t) s].c[k] += step[(size_t) s].c[k] * (float) numRamped;
+    }
+
+private:
+    struct Coefficients { float c[5] {}; }; // b0, b1, b2, a1, a2 (normalised by a0)
+
+    struct LaneGroup
+    {
+        Vec s1[numSections];
+        Vec s2[numSections];
+    };
+
+    // Base formant centres (Hz) and peak gains for F1..F3; broad peaks (Q = 1)
+    static constexpr float baseFrequencies[numSections] { 500.0f, 1500.0f, 2500.0f };
+    static constexpr float gains[numSections] { 1.5f, 1.5f, 1.3f };
+    static constexpr float q = 1.0f;
+
+    double sampleRate { 44100.0 };
+    std::vector<LaneGroup> groups;
+    std::array<Coefficients, numSections> current {}, target {}, step {};
+    int rampRemaining { 0 };
+    float lastShift { 0.0f };
+
+    // Same response as juce::dsp::IIR::Coefficients::makePeakFilter, without the heap allocation
+    Coefficients makePeak(float frequency, float quality, float gainFactor) const
+    {
+        const double A = std::sqrt(juce::jmax(0.0, (double) gainFactor));
+        const double omega = juce::MathConstants<double>::twoPi * juce::jmax((double) frequency, 2.0) / sampleRate;
+        const double alpha = std::sin(omega) / (quality * 2.0);
+        const double c2 = -2.0 * std::cos(omega);
+        const double alphaTimesA = alpha * A;
+        const double alphaOverA = alpha / A;
+        const double a0 = 1.0 + alphaOverA;
+
+        Coefficients result;
+        result.c[0] = (float) ((1.0 + alphaTimesA) / a0);
+        result.c[1] = (float) (c2 / a0);
+        result.c[2] = (float) ((1.0 - alphaTimesA) / a0);
+        result.c[3] = (float) (c2 / a0);
+        result.c[4] = (float) ((1.0 - alphaOverA) / a0);
+        return result;
+    }
+};
@@ -0,0 +1,216 @@
+// TitanVocal - Proprietary Noise Gate
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: NoiseGate.h
+// Description: Streaming lookahead gate/expander with peak envelope, hysteresis, hold and smoothed gain.
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "FastMath.h"
+#include "../Core/QuantumParameters.h"
+
+// The detector runs at control rate: a peak per 16-sample sub-block drives the envelope, the
+// open/closed state and the gain curve. The gain is then ramped linearly across the next sub-block.
+// The signal passes through a short lookahead delay so the gate is already open when an onset
+// arrives. Per-sample work is a max, a ramp fill and two delay-line copies, all branch-free.
+class NoiseGate
+{
+public:
+    static constexpr int subBlockSize = 16;
+
+    NoiseGate() = default;
+
+    // Allocates per-channel delay lines. Not real-time safe.
+    void prepare(double newSampleRate, int maxChannels, int maxBlockSize)
+    {
+        sampleRate = newSampleRate;
+        fullLookahead = juce::jmax(2 * subBlockSize, juce::roundToInt(0.001 * sampleRate));
+        lookahead = fullLookahead;
+        holdSubBlocks = juce::roundToInt(0.02 * sampleRate / subBlockSize);
+
+        const double subBlockRate = sampleRate / subBlockSize;
+        // Attack is instant at control rate (the per-sample ramp and the lookahead soften it)
+        envelopeRelease = coefficientFor(0.020, subBlockRate);
+        gainRelease     = coefficientFor(0.080, subBlockRate);
+
+        int size = 1;
+        while (size < fullLookahead + maxBlockSize)
+            size <<= 1;
+        delayMask = size - 1;
+
+        channels.resize((size_t) juce::jmax(1, maxChannels));
+        for (auto& state : channels)
+        {
+            state.signalDelay.assign((size_t) size, 0.0f);
+            state.companionDelay.assign((size_t) size, 0.0f);
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        for (auto& state : channels)
+        {
+            std::fill(state.signalDelay.begin(), state.signalDelay.end(), 0.0f);
+            std::fill(state.companionDelay.begin(), state.companionDelay.end(), 0.0f);
+            state.writePos = 0;
+            state.subBlockPosition = 0;
+            state.subBlockPeak = 0.0f;
+            state.envelope = 0.0f;
+            state.open = false;
+            state.holdRemaining = 0;
+            state.gainDb = 0.0f;
+            state.gain = 1.0f;
+            state.gainStep = 0.0f;
+        }
+    }
+
+    // amount scales both how far the threshold rises above params.threshold (up to +24 dB) and how
+    // much of params.reduction is applied below it. amount = 0 leaves the signal untouched.
+    void setParameters(const QuantumParameters::NoiseParams& params)
+    {
+        const float amount = juce::jlimit(0.0f, 1.0f, params.amount);
+        openThresholdDb = params.threshold + 24.0f * amount;
+        closeThresholdDb = openThresholdDb - hysteresisDb;
+        rangeDb = amount * juce::jmax(0.0f, params.reduction);
+    }
+
+    int getLatencySamples() const { return lookahead; }
+
+    // Without lookahead nothing is delayed and the gate opens one sub-block late on onsets.
+    // Switching restarts the delay lines.
+    void setLookaheadEnabled(bool shouldLookAhead)
+    {
+        const int newLookahead = shouldLookAhead ? fullLookahead : 0;
+        if (newLookahead != lookahead)
+        {
+            lookahead = newLookahead;
+            reset();
+        }
+    }
+
+    // Delays signal (and companion, if non-null) in place by the lookahead and writes the gate gain
+    // for the delayed signal to gain. Returns false if every gain in the block is exactly 1, so the
+    // caller can skip applying it.
+    bool process(int channel, float* signal, float* companion, float* gain, int numSamples)
+    {
+        jassert(channel < (int) channels.size() && numSamples + lookahead <= delayMask + 1);
+        auto& state = channels[(size_t) juce::jmin(channel, (int) channels.size() - 1)];
+        bool anyReduction = false;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int length = juce::jmin(subBlockSize - state.subBlockPosition, numSamples - start);
+
+            float peak = state.subBlockPeak;
+            for (int i = start; i < start + length; ++i)
+                peak = juce::jmax(peak, std::abs(signal[i]));
+            state.subBlockPeak = peak;
+
+            const float step = state.gainStep;
+            const float base = state.gain + step * (float) state.subBlockPosition;
+            for (int i = 0; i < length; ++i)
+                gain[start + i] = base + step * (float) (i + 1);
+            anyReduction |= juce::jmin(base, base + step * (float) length) < 1.0f;
+
+            state.subBlockPosition += length;
+            start += length;
+            if (state.subBlockPosition == subBlockSize)
+                endSubBlock(state);
+        }
+
+        if (lookahead > 0)
+        {
+            delay(state.signalDelay, state.writePos, signal, numSamples);
+            if (companion != nullptr)
+                delay(state.companionDelay, state.writePos, companion, numSamples);
+            state.writePos = (state.writePos + numSamples) & delayMask;
+        }
+
+        return anyReduction;
+    }
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> signalDelay, companionDelay;
+        int writePos = 0;
+        int subBlockPosition = 0;
+        float subBlockPeak = 0.0f;
+        float envelope = 0.0f;
+        bool open = false;
+        int holdRemaining = 0;
+        float gainDb = 0.0f;     // smoothed, <= 0
+        float gain = 1.0f;       // gain at the end of the previous sub-block
+        float gainStep = 0.0f;   // per-sample ramp across the current sub-block
+    };
+
+    static constexpr float hysteresisDb = 6.0f;
+    static constexpr float expansionSlope = 2.0f;   // dB of reduction per dB below threshold
+
+    double sampleRate { 44100.0 };
+    std::vector<ChannelState> channels;
+    int delayMask { 0 };
+    int lookahead { 0 }, fullLookahead { 0 };
+    int holdSubBlocks { 0 };
+    float envelopeRelease { 0.0f }, gainRelease { 0.0f };
+    float openThresholdDb { -60.0f }, closeThresholdDb { -66.0f }, rangeDb { 0.0f };
+
+    static float coefficientFor(double seconds, double updateRate)
+    {
+        return (float) (1.0 - std::exp(-1.0 / (seconds * updateRate)));
+    }
+
+    // Control-rate update: envelope, hysteresis/hold, gain curve and gain smoothing
+    void endSubBlock(ChannelState& state)
+    {
+        const float peak = state.subBlockPeak;
+        state.envelope = juce::jmax(peak, state.envelope + envelopeRelease * (peak - state.envelope));
+        const float levelDb = FastMath::gainToDecibels(state.envelope);
+
+        // Opens above the open threshold; closes below the lower close threshold once hold runs out
+        if (levelDb > openThresholdDb)
+        {
+            state.open = true;
+            state.holdRemaining = holdSubBlocks;
+        }
+        else if (state.holdRemaining > 0)
+        {
+            --state.holdRemaining;
+        }
+        else if (levelDb < closeThresholdDb)
+        {
+            state.open = false;
+        }
+
+        // Expander curve against whichever threshold the state is holding: 0 dB above it, sloping
+        // down to -range below
+        const float threshold = state.open ? closeThresholdDb : openThresholdDb;
+        const float targetDb = juce::jlimit(-rangeDb, 0.0f, (levelDb - threshold) * expansionSlope);
+        state.gainDb = juce::jmax(targetDb, state.gainDb + gainRelease * (targetDb - state.gainDb));
+
+        const float previous = state.gain + state.gainStep * (float) subBlockSize;
+        const float next = FastMath::decibelsToGain(state.gainDb);
+        state.gain = previous;
+        state.gainStep = (next - previous) / (float) subBlockSize;
+        state.subBlockPosition = 0;
+        state.subBlockPeak = 0.0f;
+    }
+
+    void delay(std::vector<float>& line, int writePos, float* samples, int numSamples) const
+    {
+        const int size = delayMask + 1;
+        const int firstWrite = juce::jmin(numSamples, size - writePos);
+        std::copy(samples, samples + firstWrite, line.data() + writePos);
+        std::copy(samples + firstWrite, samples + numSamples, line.data());
+
+        const int readPos = (writePos - lookahead) & delayMask;
+        const int firstRead = juce::jmin(numSamples, size - readPos);
+        std::copy(line.data() + readPos, line.data() + readPos + firstRead, samples);
+        std::copy(line.data(), line.data() + (numSamples - firstRead), samples + firstRead);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(NoiseGate)
+};
@@ -0,0 +1,73 @@
+// TitanVocal - Proprietary Output Stage Kernel
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: OutputStage.h
+// Description: Fused single-pass gate, saturation, dry/wet mix and output gain.
+#pragma once
+
+#include <JuceHeader.h>
+#include "FastMath.h"
+
+namespace OutputStage
+{
+    // Per-block controls. Ramps are per-sample arrays covering the whole block.
+    struct Controls
+    {
+        const float* gateGain = nullptr;
+        const float* saturation = nullptr;
+        const float* dryWet = nullptr;
+        const float* gain = nullptr;
+    };
+
+    // Gate -> saturation -> mix -> gain for one vector (or one sample) at index i
+    template <bool Gate, bool Saturate, typename Ops>
+    void processFrame(const float* processed, const float* dry, float* out, const Controls& c, int i)
+    {
+        auto wet = Ops::load(processed + i);
+        if constexpr (Gate)
+            wet = Ops::mul(wet, Ops::load(c.gateGain + i));
+        if constexpr (Saturate)
+            wet = Ops::mulAdd(Ops::load(c.saturation + i), Ops::sub(FastMath::simd::tanh<Ops>(wet), wet), wet);
+
+        const auto d = Ops::load(dry + i);
+        Ops::store(out + i, Ops::mul(Ops::mulAdd(Ops::load(c.dryWet + i), Ops::sub(wet, d), d), Ops::load(c.gain + i)));
+    }
+
+    // Samples [start, end) in one pass: each sample is loaded and stored once, with no per-sample
+    // branches. Runs on FastMath's vector unit with a scalar tail.
+    template <bool Gate, bool Saturate>
+    void processDsp(const float* processed, const float* dry, float* out, const Controls& c, int start, int end)
+    {
+        using Vector = FastMath::simd::VectorOps;
+        using Scalar = FastMath::simd::ScalarOps;
+
+        int i = start;
+        for (; i + Vector::width <= end; i += Vector::width)
+            processFrame<Gate, Saturate, Vector>(processed, dry, out, c, i);
+        for (; i < end; ++i)
+            processFrame<Gate, Saturate, Scalar>(processed, dry, out, c, i);
+    }
+
+    // Mix and gain only, for samples whose wet signal comes from the AI stream
+    inline void processExternalWet(const float* wet, const float* dry, float* out, const Controls& c, int start, int end)
+    {
+        const float* dryWet = c.dryWet;
+        const float* gain = c.gain;
+        for (int i = start; i < end; ++i)
+            out[i] = (dry[i] + dryWet[i] * (wet[i] - dry[i])) * gain[i];
+    }
+
+    // Picks the instantiation for the stages that can change the signal this block
+    inline void processDsp(bool gate, bool saturate, const float* processed, const float* dry, float* out,
+                           const Controls& c, int start, int end)
+    {
+        if (start >= end)
+            return;
+
+        if (gate && saturate)   processDsp<true,  true >(processed, dry, out, c, start, end);
+        else if (gate)          processDsp<true,  false>(processed, dry, out, c, start, end);
+        else if (saturate)      processDsp<false, true >(processed, dry, out, c, start, end);
+        else                    processDsp<false, false>(processed, dry, out, c, start, end);
+    }
+}
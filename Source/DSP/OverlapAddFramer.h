@@ -0,0 +1,127 @@
+// TitanVocal - Proprietary Overlap-Add Framer
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: OverlapAddFramer.h
+// Description: Analysis/synthesis windows and overlap-add reconstruction for one AI frame stream.
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Frames of frameSize samples are cut every hopSize samples. Each one is weighted by the analysis
+// window before inference, and the processed frame by the synthesis window. Both are square-root
+// periodic Hann, so their product is Hann, which sums to a constant at any hop that divides half
+// the frame; the synthesis window carries the gain that makes that constant one. With hop equal
+// to frame the windows are rectangular and frames simply follow each other.
+//
+// A stream starts with frameSize - hopSize samples of silence in front of the input, so that the
+// first frame is due after one hop and every real sample is covered by a full set of windows. The
+// output those silent samples produce is dropped, so output sample n is input sample n, finished
+// once the last frame covering it has been added: at most frameSize samples after it came in.
+class OverlapAddFramer
+{
+public:
+    OverlapAddFramer() = default;
+
+    // Not real-time safe: allocates for frames of up to maxFrameSize
+    void prepare(int maxFrameSize)
+    {
+        const auto size = (size_t) juce::jmax(1, maxFrameSize);
+        analysis.assign(size, 1.0f);
+        synthesis.assign(size, 1.0f);
+        accumulator.assign(size, 0.0f);
+        finished.assign(size, 0.0f);
+        frameSize = hopSize = (int) size;
+        reset();
+    }
+
+    // Audio thread (no allocation). hopSize must divide frameSize / 2, or equal frameSize. Resets.
+    void setFraming(int newFrameSize, int newHopSize)
+    {
+        newFrameSize = juce::jlimit(1, (int) accumulator.size(), newFrameSize);
+        newHopSize = juce::jlimit(1, newFrameSize, newHopSize);
+        jassert(newHopSize == newFrameSize || (newFrameSize / 2) % newHopSize == 0);
+
+        if (newFrameSize != frameSize || newHopSize != hopSize)
+        {
+            frameSize = newFrameSize;
+            hopSize = newHopSize;
+            computeWindows();
+        }
+        reset();
+    }
+
+    int getFrameSize() const { return frameSize; }
+    int getHopSize() const { return hopSize; }
+
+    // Silence the input stream has to start with
+    int getLeadInSamples() const { return frameSize - hopSize; }
+
+    // Starts a new stream; the caller primes its input with getLeadInSamples() of silence
+    void reset()
+    {
+        std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+        leadInToDrop = getLeadInSamples();
+    }
+
+    void applyAnalysisWindow(float* frame) const
+    {
+        if (hopSize < frameSize)
+            juce::FloatVectorOperations::multiply(frame, analysis.data(), frameSize);
+    }
+
+    // Adds the next processed frame (frameSize samples, frames in stream order). Returns the
+    // samples it finished, of which there are numFinished: a hop, less any lead-in still dropped.
+    const float* addFrame(const float* frame, int& numFinished)
+    {
+        if (hopSize < frameSize)
+        {
+            juce::FloatVectorOperations::addWithMultiply(accumulator.data(), frame, synthesis.data(), frameSize);
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(accumulator.data(), frame, frameSize);
+        }
+
+        // The first hop has had every frame it will get; move it out and shift the rest down
+        std::copy(accumulator.begin(), accumulator.begin() + hopSize, finished.begin());
+        std::copy(accumulator.begin() + hopSize, accumulator.begin() + frameSize, accumulator.begin());
+        std::fill(accumulator.begin() + (frameSize - hopSize), accumulator.begin() + frameSize, 0.0f);
+
+        const int dropped = juce::jmin(leadInToDrop, hopSize);
+        leadInToDrop -= dropped;
+        numFinished = hopSize - dropped;
+        return finished.data() + dropped;
+    }
+
+private:
+    std::vector<float> analysis, synthesis;
+    std::vector<float> accumulator, finished;
+    int frameSize { 1 };
+    int hopSize { 1 };
+    int leadInToDrop { 0 };
+
+    void computeWindows()
+    {
+        if (hopSize == frameSize)
+        {
+            std::fill(analysis.begin(), analysis.end(), 1.0f);
+            std::fill(synthesis.begin(), synthesis.end(), 1.0f);
+            return;
+        }
+
+        // Periodic Hann overlapped every hop sums to frame / (2 * hop)
+        const float gain = 2.0f * (float) hopSize / (float) frameSize;
+        for (int n = 0; n < frameSize; ++n)
+        {
+            const float hann = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) n / (float) frameSize);
+            analysis[(size_t) n] = std::sqrt(hann);
+            synthesis[(size_t) n] = std::sqrt(hann) * gain;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(OverlapAddFramer)
+};
@@ -0,0 +1,248 @@
+// TitanVocal - Proprietary Streaming Pitch Shifter Implementation
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: PitchShifter.cpp
+// Description: Implements the two-head pitch-synchronous shifter and its decimated AMDF period tracker.
+#include "PitchShifter.h"
+
+namespace
+{
+    constexpr double analysisRate = 12000.0;   // pitch tracking runs at roughly this rate
+    constexpr double lowestPitch = 75.0;       // Hz
+    constexpr double highestPitch = 1000.0;    // Hz
+    constexpr int windowTableSize = 512;
+
+    int nextPowerOfTwoAtLeast(int n)
+    {
+        int size = 1;
+        while (size < n)
+            size <<= 1;
+        return size;
+    }
+}
+
+void PitchShifter::prepare(double sampleRate, int maxBlockSize)
+{
+    juce::ignoreUnused(maxBlockSize);
+
+    decimation = juce::jmax(1, juce::roundToInt(sampleRate / analysisRate));
+    const double decimatedRate = sampleRate / decimation;
+    minLag = juce::jmax(2, (int) (decimatedRate / highestPitch));
+    maxLag = (int) std::ceil(decimatedRate / lowestPitch);
+    analysisWindow = maxLag;
+    analysisHop = juce::jmax(1, (int) (sampleRate * 0.01));
+    // Finish each estimate within half a hop so analyses never overlap
+    lagsPerSample = (float) (maxLag - minLag + 1) / (0.5f * (float) analysisHop);
+
+    decimated.assign((size_t) nextPowerOfTwoAtLeast(analysisWindow + maxLag + analysisHop / decimation + 4), 0.0f);
+    decimatedMask = (int) decimated.size() - 1;
+    amdf.assign((size_t) maxLag + 2, 0.0f);
+
+    // A window spans one and a half of the longest periods; restart points leave half a period of
+    // room either side for the whole-period snap, plus interpolation margin at the near end.
+    const double maxPeriod = (double) (maxLag * decimation);
+    defaultPeriod = sampleRate / 150.0;
+    span = 1.5 * maxPeriod;
+    lowDelay = 2.0;
+    lowStart = lowDelay + 0.5 * maxPeriod;
+    highStart = lowStart + span;
+    highDelay = highStart + 0.5 * maxPeriod;
+    compensatedLatency = juce::roundToInt(0.5 * (lowStart + highStart));
+    latency = compensatedLatency;
+
+    history.assign((size_t) nextPowerOfTwoAtLeast((int) highDelay + 4), 0.0f);
+    historyMask = (int) history.size() - 1;
+
+    window.resize(windowTableSize + 1);
+    for (int i = 0; i <= windowTableSize; ++i)
+    {
+        const double s = std::sin(juce::MathConstants<double>::pi * i / windowTableSize);
+        window[(size_t) i] = (float) (s * s);
+    }
+
+    ratioGlide = (float) (1.0 / (0.005 * sampleRate));
+    bypassStep = (float) (1.0 / (0.01 * sampleRate));
+    reset();
+}
+
+void PitchShifter::reset()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    std::fill(decimated.begin(), decimated.end(), 0.0f);
+    writePos = 0;
+    decimatedWritePos = 0;
+    decimationCount = 0;
+    decimationSum = 0.0f;
+
+    heads[0].phase = 0.0;
+    heads[1].phase = 0.5;
+    for (auto& head : heads)
+        head.delay = lowStart + head.phase * span;
+
+    ratio = targetRatio;
+    bypassMix = std::abs(ratio - 1.0f) < 1.0e-4f ? 1.0f : 0.0f;
+
+    period = defaultPeriod;
+    samplesUntilAnalysis = analysisHop;
+    nextLag = -1;
+    lagBudget = 0.0f;
+}
+
+void PitchShifter::process(const float* input, float* output, float* delayedDry, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[(size_t) writePos] = input[i];
+        pushDecimated(input[i]);
+
+        ratio += juce::jlimit(-ratioGlide, ratioGlide, targetRatio - ratio);
+        const bool unity = std::abs(ratio - 1.0f) < 1.0e-4f;
+        bypassMix = juce::jlimit(0.0f, 1.0f, bypassMix + (unity ? bypassStep : -bypassStep));
+
+        // Each head's read point moves at `ratio` samples per sample, so its delay moves by 1 - ratio
+        const double rate = unity ? 0.0 : 1.0 - (double) ratio;
+        const double phaseStep = std::abs(rate) / span;
+        for (int h = 0; h < 2; ++h)
+        {
+            auto& head = heads[h];
+            head.phase += phaseStep;
+            if (head.phase >= 1.0)
+            {
+                head.phase -= 1.0;
+                restartHead(head, heads[1 - h], rate > 0.0);
+            }
+            head.delay = juce::jlimit(lowDelay, highDelay, head.delay + rate);
+        }
+
+        const float w = readWindow(heads[0].phase);
+        const float shifted = w * readHistory(heads[0].delay) + (1.0f - w) * readHistory(heads[1].delay);
+        const float dry = history[(size_t) ((writePos - latency) & historyMask)];
+
+        output[i] = shifted + bypassMix * (dry - shifted);
+        if (delayedDry != nullptr)
+            delayedDry[i] = dry;
+
+        writePos = (writePos + 1) & historyMask;
+    }
+
+    advanceAnalysis(numSamples);
+}
+
+float PitchShifter::readHistory(double delay) const
+{
+    // 4-point Hermite interpolation around the read position
+    const double pos = (double) writePos - delay;
+    const double base = std::floor(pos);
+    const int i = (int) base;
+    const float t = (float) (pos - base);
+
+    const float xm1 = history[(size_t) ((i - 1) & historyMask)];
+    const float x0  = history[(size_t) (i & historyMask)];
+    const float x1  = history[(size_t) ((i + 1) & historyMask)];
+    const float x2  = history[(size_t) ((i + 2) & historyMask)];
+
+    const float c1 = 0.5f * (x1 - xm1);
+    const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+    const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    return ((c3 * t + c2) * t + c1) * t + x0;
+}
+
+float PitchShifter::readWindow(double phase) const
+{
+    const double pos = phase * windowTableSize;
+    const int i = juce::jlimit(0, windowTableSize - 1, (int) pos);
+    const float t = (float) (pos - i);
+    return window[(size_t) i] + t * (window[(size_t) i + 1] - window[(size_t) i]);
+}
+
+void PitchShifter::restartHead(Head& head, const Head& other, bool delayGrowing) const
+{
+    // The restarting head is silent right now; put it a whole number of periods away from the
+    // audible head so the two are in phase while they cross-fade.
+    const double start = delayGrowing ? lowStart : highStart;
+    const double periods = std::round((start - other.delay) / period);
+    head.delay = juce::jlimit(lowDelay, highDelay, other.delay + periods * period);
+}
+
+void PitchShifter::pushDecimated(float x)
+{
+    // Box-car average is enough of an anti-alias filter for period tracking
+    decimationSum += x;
+    if (++decimationCount < decimation)
+        return;
+
+    decimated[(size_t) decimatedWritePos] = decimationSum / (float) decimation;
+    decimatedWritePos = (decimatedWritePos + 1) & decimatedMask;
+    decimationCount = 0;
+    decimationSum = 0.0f;
+}
+
+void PitchShifter::advanceAnalysis(int numSamples)
+{
+    samplesUntilAnalysis -= numSamples;
+    if (samplesUntilAnalysis <= 0 && nextLag < 0)
+    {
+        samplesUntilAnalysis += analysisHop;
+        analysisEnd = decimatedWritePos;
+        nextLag = minLag;
+        lagBudget = 0.0f;
+    }
+
+    if (nextLag < 0)
+        return;
+
+    // A fixed number of lags per input sample keeps the cost flat instead of spiking once per hop
+    lagBudget += lagsPerSample * (float) numSamples;
+    while (lagBudget >= 1.0f && nextLag <= maxLag)
+    {
+        float sum = 0.0f;
+        for (int k = 1; k <= analysisWindow; ++k)
+        {
+            const int n = analysisEnd - k;
+            sum += std::abs(decimated[(size_t) (n & decimatedMask)] - decimated[(size_t) ((n - nextLag) & decimatedMask)]);
+        }
+        amdf[(size_t) nextLag] = sum / (float) analysisWindow;
+        ++nextLag;
+        lagBudget -= 1.0f;
+    }
+
+    if (nextLag > maxLag)
+    {
+        finishAnalysis();
+        nextLag = -1;
+    }
+}
+
+void PitchShifter::finishAnalysis()
+{
+    float lowest = amdf[(size_t) minLag];
+    float mean = 0.0f;
+    for (int lag = minLag; lag <= maxLag; ++lag)
+    {
+        lowest = juce::jmin(lowest, amdf[(size_t) lag]);
+        mean += amdf[(size_t) lag];
+    }
+    mean /= (float) (maxLag - minLag + 1);
+
+    // Unvoiced or silent: keep the previous period so splices stay consistent
+    if (mean < 1.0e-5f || lowest > 0.35f * mean)
+        return;
+
+    // Take the first dip close to the global minimum to avoid locking onto a multiple of the period
+    const float threshold = lowest + 0.15f * (mean - lowest);
+    int lag = minLag;
+    while (lag < maxLag && ! (amdf[(size_t) lag] <= threshold && amdf[(size_t) lag] <= amdf[(size_t) lag + 1]))
+        ++lag;
+
+    double refined = (double) lag;
+    if (lag > minLag && lag < maxLag)
+    {
+        const double a = amdf[(size_t) lag - 1], b = amdf[(size_t) lag], c = amdf[(size_t) lag + 1];
+        const double denominator = a - 2.0 * b + c;
+        if (denominator > 0.0)
+            refined += juce::jlimit(-0.5, 0.5, 0.5 * (a - c) / denominator);
+    }
+
+    period = refined * decimation;
+}
@@ -0,0 +1,90 @@
+// TitanVocal - Proprietary Streaming Pitch Shifter
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: PitchShifter.h
+// Description: Streaming pitch-synchronous overlap-add pitch shifter with fixed latency (one instance per channel).
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+// Two read heads slide through a history buffer at the shift ratio, each under a Hann window,
+// offset by half a window so their gains always sum to one. When a head's window reaches zero it
+// jumps back by a whole number of detected pitch periods, so every splice lands in phase with
+// the waveform (the pitch marks). The period is tracked with an AMDF on a ~12 kHz decimated copy
+// of the input, spread over the analysis hop so the per-sample cost stays constant.
+class PitchShifter
+{
+public:
+    PitchShifter() = default;
+
+    // Allocates the history buffers. Not real-time safe.
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    // Fixed delay of both outputs, independent of ratio and block size.
+    int getLatencySamples() const { return latency; }
+
+    // With compensation off the dry output (and the unity-ratio bypass) is the undelayed input and
+    // the latency is zero. The shifted signal keeps its inherent window delay either way.
+    void setLatencyCompensated(bool shouldCompensate) { latency = shouldCompensate ? compensatedLatency : 0; }
+
+    // Playback-rate ratio, e.g. 2.0 = up one octave. Glides to the new value over a few ms.
+    void setRatio(float newRatio) { targetRatio = juce::jlimit(0.25f, 4.0f, newRatio); }
+
+    // Writes the shifted signal to output and, if delayedDry is non-null, the input delayed by
+    // the same latency (for phase-coherent dry/wet mixing). Input and outputs may not alias.
+    void process(const float* input, float* output, float* delayedDry, int numSamples);
+
+private:
+    struct Head
+    {
+        double delay = 0.0;  // samples behind the write position
+        double phase = 0.0;  // 0..1 through this head's window
+    };
+
+    // History of the full-rate input
+    std::vector<float> history;
+    int historyMask { 0 };
+    int writePos { 0 };
+
+    // Synthesis. The heads' phases stay exactly half a window apart, so the second window is 1 - the first.
+    Head heads[2];
+    std::vector<float> window;  // sin^2 over one window, plus a guard point
+    double span { 0.0 };        // window length in samples
+    double lowStart { 0.0 };    // where a head restarts when delays grow (pitch down)
+    double highStart { 0.0 };   // where a head restarts when delays shrink (pitch up)
+    double lowDelay { 0.0 };    // hard bounds for the heads
+    double highDelay { 0.0 };
+    int latency { 0 };
+    int compensatedLatency { 0 };
+    float ratio { 1.0f }, targetRatio { 1.0f }, ratioGlide { 0.001f };
+    float bypassMix { 1.0f }, bypassStep { 0.001f };
+
+    // Pitch tracking on the decimated signal
+    std::vector<float> decimated;
+    int decimatedMask { 0 };
+    int decimatedWritePos { 0 };
+    int decimation { 4 };
+    int decimationCount { 0 };
+    float decimationSum { 0.0f };
+    int minLag { 12 }, maxLag { 160 }, analysisWindow { 160 };
+    int analysisHop { 512 };      // full-rate samples between period estimates
+    int samplesUntilAnalysis { 0 };
+    int analysisEnd { 0 };        // decimated position the running analysis is anchored to
+    int nextLag { -1 };           // -1 when no analysis is in progress
+    float lagsPerSample { 0.0f }, lagBudget { 0.0f };
+    std::vector<float> amdf;      // indexed by lag
+    double period { 0.0 };        // current pitch period in full-rate samples
+    double defaultPeriod { 0.0 };
+
+    float readHistory(double delay) const;
+    float readWindow(double phase) const;
+    void pushDecimated(float x);
+    void advanceAnalysis(int numSamples);
+    void finishAnalysis();
+    void restartHead(Head& head, const Head& other, bool delayGrowing) const;
+
+    JUCE_DECLARE_NON_COPYABLE(PitchShifter)
+};
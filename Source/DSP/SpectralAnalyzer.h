@@ -13,6 +13,7 @@ public:
           window(fftSize, juce::dsp::WindowingFunction<float>::hann)
     {
         timeDomainBuffer.resize(fftSize);
+        scratchBuffer.resize(fftSize);
         freqDomainBuffer.resize(fftSize * 2);
         magnitudeBuffer.resize(fftSize / 2);
     }
@@ -29,8 +30,7 @@ public:
 
     void computeSpectrum()
     {
-        // Copy the latest windowed chunk into a scratch buffer
-        scratchBuffer.resize(fftSize);
+        // Copy the latest windowed chunk into a scratch buffer (sized in the constructor)
         for (int i = 0; i < fftSize; ++i)
         {
             int idx = (writeIndex + i) % fftSize;
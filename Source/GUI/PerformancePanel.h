@@ -0,0 +1,172 @@
+// TitanVocal - Proprietary Performance Panel
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: PerformancePanel.h
+// Description: Shows each processBlock stage's share of the block budget, its rolling max and deadline overruns.
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <deque>
+#include "../Core/StageTelemetry.h"
+#include "../AI/AIModelInterface.h"
+
+class PerformancePanel : public juce::Component
+{
+public:
+    PerformancePanel() { setOpaque(true); }
+
+    // Editor timer: feeds the records drained from the processor since the last tick
+    void addBlocks(const StageTelemetry::BlockTimings* blocks, int numBlocks)
+    {
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            const auto& block = blocks[i];
+            if (block.budgetMicros <= 0.0f)
+                continue;
+
+            for (int s = 0; s < numProcessingStages; ++s)
+            {
+                tickMicros[(size_t) s] += block.stageMicros[(size_t) s];
+                tickPeak[(size_t) s] = juce::jmax(tickPeak[(size_t) s], block.stageMicros[(size_t) s] / block.budgetMicros);
+            }
+            tickMicros[totalRow] += block.blockMicros;
+            tickPeak[totalRow] = juce::jmax(tickPeak[totalRow], block.blockMicros / block.budgetMicros);
+            tickBudget += block.budgetMicros;
+
+            ++blocksSeen;
+            if (block.blockMicros > block.budgetMicros)
+                ++overruns;
+        }
+    }
+
+    // Editor timer: closes the tick. Averages become the bars, peaks feed the rolling max.
+    void update()
+    {
+        if (tickBudget > 0.0f)
+            for (size_t r = 0; r < numRows; ++r)
+                average[r] = tickMicros[r] / tickBudget;
+
+        history.push_back(tickPeak);
+        if (history.size() > historyTicks)
+            history.pop_front();
+        rollingMax.fill(0.0f);
+        for (const auto& peaks : history)
+            for (size_t r = 0; r < numRows; ++r)
+                rollingMax[r] = juce::jmax(rollingMax[r], peaks[r]);
+
+        tickMicros.fill(0.0f);
+        tickPeak.fill(0.0f);
+        tickBudget = 0.0f;
+        repaint();
+    }
+
+    juce::int64 getOverrunCount() const { return overruns; }
+
+    // Editor timer: the selected model's load profile; repaints only when a different load shows up
+    void setModelConfig(const AIModelInterface::ModelConfig& config)
+    {
+        if (config.modelPath == model.modelPath && config.loadMs == model.loadMs)
+            return;
+        model = config;
+        repaint();
+    }
+
+    void paint(juce::Graphics& g) override
+    {
+        auto area = getLocalBounds().toFloat();
+        auto bg = findColour(juce::ResizableWindow::backgroundColourId);
+
+        // Card container, matching the other panels
+        g.setGradientFill(juce::ColourGradient(bg.darker(0.15f), area.getX(), area.getY(),
+                                               bg.darker(0.10f), area.getX(), area.getBottom(), false));
+        g.fillRoundedRectangle(area.reduced(2.0f), 10.0f);
+        g.setColour(juce::Colour(0x22FFFFFF));
+        g.drawRoundedRectangle(area.reduced(2.0f), 10.0f, 1.0f);
+
+        auto content = getLocalBounds().reduced(16);
+        g.setFont(13.0f);
+        g.setColour(juce::Colours::white.withAlpha(0.7f));
+        g.drawText("Share of the block budget (bar: average, line: max over the last 3 s)",
+                   content.removeFromTop(20), juce::Justification::centredLeft);
+        content.removeFromTop(6);
+
+        auto footer = content.removeFromBottom(40);
+        paintModel(g, content.removeFromBottom(44));
+        const int rowHeight = juce::jmin(26, content.getHeight() / (int) numRows);
+        for (size_t r = 0; r < numRows; ++r)
+            paintRow(g, content.removeFromTop(rowHeight), r);
+
+        g.setColour(overruns > 0 ? juce::Colour(0xFFE05A47) : juce::Colours::white.withAlpha(0.7f));
+        g.drawText("Blocks over deadline: " + juce::String(overruns) + " of " + juce::String(blocksSeen),
+                   footer.removeFromTop(20), juce::Justification::centredLeft);
+        g.setColour(juce::Colours::white.withAlpha(0.45f));
+        g.drawText("Stage times are CPU time; stages spread over channel workers can add up to more than the block.",
+                   footer, juce::Justification::centredLeft);
+    }
+
+private:
+    static constexpr size_t numRows = (size_t) numProcessingStages + 1;
+    static constexpr size_t totalRow = (size_t) numProcessingStages;
+    static constexpr size_t historyTicks = 90; // 3 s of 30 Hz editor ticks
+
+    using Row = std::array<float, numRows>;
+    Row average {}, rollingMax {};
+    Row tickMicros {}, tickPeak {};
+    float tickBudget = 0.0f;
+    std::deque<Row> history;
+    juce::int64 overruns = 0, blocksSeen = 0;
+    AIModelInterface::ModelConfig model;
+
+    void paintModel(juce::Graphics& g, juce::Rectangle<int> area)
+    {
+        static const char* const precisionNames[] = { "FP32", "FP16", "INT8" };
+        g.setColour(juce::Colours::white.withAlpha(0.75f));
+        if (model.modelPath.empty())
+        {
+            g.drawText("AI model: none loaded", area, juce::Justification::centredLeft);
+            return;
+        }
+
+        const auto ms = [](double value) { return juce::String(value, 1) + " ms"; };
+        g.drawText("AI model: " + juce::File(juce::String(model.modelPath)).getFileName()
+                       + " (" + precisionNames[juce::jlimit(0, 2, model.precision)] + ")   load " + ms(model.loadMs)
+                       + "   optimize " + ms(model.optimizeMs),
+                   area.removeFromTop(20), juce::Justification::centredLeft);
+        g.drawText("Warm-up " + juce::String(model.warmupRuns) + " runs " + ms(model.warmupMs)
+                       + "   at " + juce::String(model.warmupFrameSize) + " samples: first " + ms(model.firstInferenceMs)
+                       + ", steady " + ms(model.steadyInferenceMs),
+                   area.removeFromTop(20), juce::Justification::centredLeft);
+    }
+
+    void paintRow(juce::Graphics& g, juce::Rectangle<int> row, size_t r)
+    {
+        const bool isTotal = r == totalRow;
+        g.setColour(juce::Colours::white.withAlpha(isTotal ? 0.95f : 0.75f));
+        g.drawText(isTotal ? juce::String("whole block") : juce::String(getProcessingStageName((ProcessingStage) r)),
+                   row.removeFromLeft(110), juce::Justification::centredLeft);
+
+        const auto text = row.removeFromRight(170);
+        g.drawText(juce::String(average[r] * 100.0f, 1) + "%   max " + juce::String(rollingMax[r] * 100.0f, 1) + "%",
+                   text, juce::Justification::centredRight);
+
+        // Bars span 0..100% of the budget; anything beyond is clipped at the right edge
+        auto track = row.reduced(8, 6).toFloat();
+        g.setColour(juce::Colours::white.withAlpha(0.08f));
+        g.fillRoundedRectangle(track, 3.0f);
+
+        const float share = juce::jlimit(0.0f, 1.0f, average[r]);
+        const auto colour = rollingMax[r] > 0.8f ? juce::Colour(0xFFE05A47)
+                          : rollingMax[r] > 0.5f ? juce::Colour(0xFFE0A047)
+                                                 : findColour(juce::Slider::thumbColourId);
+        g.setColour(colour);
+        g.fillRoundedRectangle(track.withWidth(track.getWidth() * share), 3.0f);
+
+        const float maxX = track.getX() + track.getWidth() * juce::jlimit(0.0f, 1.0f, rollingMax[r]);
+        g.setColour(colour.brighter(0.4f));
+        g.drawLine(maxX, track.getY() - 2.0f, maxX, track.getBottom() + 2.0f, 2.0f);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformancePanel)
+};
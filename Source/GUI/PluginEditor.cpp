@@ -265,6 +265,9 @@ TitanVocalEditor::TitanVocalEditor(TitanVocalProcessor& p)
     mainPage->addAndMakeVisible(*spectralDisplay);
     mainPage->addAndMakeVisible(*parameterControls);
 
+    performancePanel = std::make_unique<PerformancePanel>();
+    mainTabs.addTab("Performance", juce::Colours::darkgrey, performancePanel.get(), false);
+
     // Display mode selector
     addAndMakeVisible(displayModeBox);
     initializeDisplayModeSelector();
@@ -291,6 +294,11 @@ TitanVocalEditor::TitanVocalEditor(TitanVocalProcessor& p)
     aiModelBox.addItem("Timing Corr.", 6);
     aiModelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "aiModelType", aiModelBox);
 
+    // Latency mode selector
+    addAndMakeVisible(latencyModeBox);
+    latencyModeBox.addItemList(juce::StringArray(latencyModeChoiceNames, (int) std::size(latencyModeChoiceNames)), 1);
+    latencyModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "latencyMode", latencyModeBox);
+
     // Default preset will be accessible via toolbar (coming soon)
 
     // Meters
@@ -343,7 +351,8 @@ void TitanVocalEditor::resized()
         fb.items.add(juce::FlexItem(displayModeBox).withMinWidth(120.0f).withMaxWidth(180.0f).withHeight((float) controlsRow.getHeight()).withMargin(juce::FlexItem::Margin(0, 6, 0, 0)));
         fb.items.add(juce::FlexItem(presetSelector).withMinWidth(180.0f).withMaxWidth(260.0f).withHeight((float) controlsRow.getHeight()).withMargin(juce::FlexItem::Margin(0, 6, 0, 0)));
         fb.items.add(juce::FlexItem(aiEnabledToggle).withMinWidth(60.0f).withMaxWidth(90.0f).withHeight((float) controlsRow.getHeight()).withMargin(juce::FlexItem::Margin(0, 6, 0, 0)));
-        fb.items.add(juce::FlexItem(aiModelBox).withMinWidth(120.0f).withMaxWidth(180.0f).withHeight((float) controlsRow.getHeight()));
+        fb.items.add(juce::FlexItem(aiModelBox).withMinWidth(120.0f).withMaxWidth(180.0f).withHeight((float) controlsRow.getHeight()).withMargin(juce::FlexItem::Margin(0, 6, 0, 0)));
+        fb.items.add(juce::FlexItem(latencyModeBox).withMinWidth(120.0f).withMaxWidth(160.0f).withHeight((float) controlsRow.getHeight()));
         fb.performLayout(controlsRow);
     }
 
@@ -372,6 +381,16 @@ void TitanVocalEditor::timerCallback()
     for (auto m : mags) in = std::max(in, m);
     inputMeter.setValue(in);
     outputMeter.setValue(in);
+
+    updatePerformance();
+
+    const int latency = audioProcessor.getActiveLatencySamples();
+    if (latency != shownLatency)
+    {
+        shownLatency = latency;
+        setStatus("Latency: " + juce::String(latency) + " samples ("
+                  + juce::String(1000.0 * latency / juce::jmax(1.0, audioProcessor.getSampleRate()), 1) + " ms)");
+    }
 }
 
 void TitanVocalEditor::buttonClicked(juce::Button* button)
@@ -396,6 +415,23 @@ void TitanVocalEditor::createCreativeControls() {}
 void TitanVocalEditor::createOutputControls() {}
 
 void TitanVocalEditor::updateMeters() {}
+
+void TitanVocalEditor::updatePerformance()
+{
+    // Drain every block timed since the last tick; the panel keeps running even when hidden
+    StageTelemetry::BlockTimings timings[64];
+    for (int n; (n = audioProcessor.readStageTimings(timings, 64)) > 0;)
+        performancePanel->addBlocks(timings, n);
+    performancePanel->setModelConfig(audioProcessor.getSelectedModelConfig());
+    performancePanel->update();
+
+    const auto overruns = performancePanel->getOverrunCount();
+    if (overruns > reportedOverruns)
+    {
+        setStatus(juce::String(overruns - reportedOverruns) + " block(s) over the CPU deadline - see the Performance tab");
+        reportedOverruns = overruns;
+    }
+}
 void TitanVocalEditor::loadPreset() {
     // Use async file chooser to avoid JUCE_MODAL_LOOPS_PERMITTED requirements in plugin hosts
     activeFileChooser = std::make_unique<juce::FileChooser>(
@@ -419,40 +455,10 @@ void TitanVocalEditor::loadPreset() {
         }
 
         std::unique_ptr<juce::XmlElement> xml (juce::XmlDocument::parse(file));
-        if (xml.get() != nullptr)
-        {
-            // Support simple <Parameters><Parameter id="..." value="..."/></Parameters> format
-            if (xml->hasTagName("Parameters"))
-            {
-                forEachXmlChildElement(*xml, child)
-                {
-                    if (child->hasTagName("Parameter"))
-                    {
-                        auto id = child->getStringAttribute("id");
-                        auto value = (float) child->getDoubleAttribute("value");
-                        if (auto* p = audioProcessor.apvts.getParameter(id))
-                            p->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
-                    }
-                }
-                setStatus("Preset loaded");
-                return;
-            }
-
-            // Fallback: try to replace APVTS state directly if compatible
-            if (xml->hasTagName(audioProcessor.apvts.state.getType()))
-            {
-                audioProcessor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
-                setStatus("Preset state applied");
-            }
-            else
-            {
-                setStatus("Unsupported preset format");
-            }
-        }
-        else
-        {
+        if (xml.get() == nullptr)
             setStatus("Failed to parse preset file");
-        }
+        else
+            setStatus(audioProcessor.applyPreset(*xml) ? "Preset loaded" : "Unsupported preset format");
     });
 }
 void TitanVocalEditor::savePreset() {
@@ -490,14 +496,9 @@ void TitanVocalEditor::savePreset() {
                 xmlRoot.addChildElement(child);
             }
         };
-        addParam("dryWet");
-        addParam("outputGain");
-        addParam("pitchAmount");
-        addParam("pitchSpeed");
-        addParam("formantShift");
-        addParam("noiseAmount");
-        addParam("saturation");
-        addParam("aiEnabled");
+        for (const auto& spec : parameterTable)
+            if (spec.savedInPreset)
+                addParam(spec.id);
         xmlRoot.writeToFile(file, {});
 
         if (file.existsAsFile() && file.getSize() > 0)
@@ -537,26 +538,8 @@ void TitanVocalEditor::loadDefaultPreset()
         return;
     }
     std::unique_ptr<juce::XmlElement> xml (juce::XmlDocument::parse(defaultPreset));
-    if (xml.get() != nullptr)
-    {
-        if (xml->hasTagName("Parameters"))
-        {
-            forEachXmlChildElement(*xml, child)
-            {
-                if (child->hasTagName("Parameter"))
-                {
-                    auto id = child->getStringAttribute("id");
-                    auto value = (float) child->getDoubleAttribute("value");
-                    if (auto* p = audioProcessor.apvts.getParameter(id))
-                        p->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
-                }
-            }
-            return;
-        }
-        if (xml->hasTagName(audioProcessor.apvts.state.getType()))
-            audioProcessor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    if (xml.get() != nullptr && audioProcessor.applyPreset(*xml))
         setStatus("Default preset applied");
-    }
 }
 
 void TitanVocalEditor::setStatus(const juce::String& text)
@@ -12,6 +12,7 @@
 #include "../Plugin/PluginProcessor.h"
 #include "SpectralDisplay.h"
 #include "ParameterControls.h"
+#include "PerformancePanel.h"
 #include "Theme.h"
 #include <deque>
 
@@ -53,6 +54,8 @@ private:
     // Main components
     std::unique_ptr<SpectralDisplay> spectralDisplay;
     std::unique_ptr<ParameterControls> parameterControls;
+    std::unique_ptr<PerformancePanel> performancePanel;
+    juce::int64 reportedOverruns = 0;
 
     // Display mode selector
     juce::ComboBox displayModeBox;
@@ -65,6 +68,11 @@ private:
     juce::ComboBox aiModelBox;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> aiModelAttachment;
 
+    // Latency mode selection; the status bar shows the resulting latency whenever it changes
+    juce::ComboBox latencyModeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> latencyModeAttachment;
+    int shownLatency = -1;
+
     // UI Sections
     juce::TabbedComponent mainTabs;
 
@@ -90,6 +98,7 @@ private:
     void createOutputControls();
 
     void updateMeters();
+    void updatePerformance();
     void loadPreset();
     void savePreset();
     void loadDefaultPreset();
@@ -1,5 +1,6 @@
 // C:/Vocal Plugin/TitanVocal/Source/GUI/SpectralDisplay.cpp
 #include "SpectralDisplay.h"
+#include "../DSP/FastMath.h"
 
 SpectralDisplay::SpectralDisplay(SpectralAnalyzer& analyzer, juce::AudioProcessorValueTreeState& apvts)
     : spectralAnalyzer(analyzer), parameters(apvts)
@@ -177,7 +178,7 @@ void SpectralDisplay::drawRealTimeFFT(juce::Graphics& g)
     for (size_t i = 0; i < mags.size(); ++i)
     {
         float x = area.getX() + dx * (float) i;
-        float y = area.getBottom() - std::log1p(mags[i]) * 20.0f; // log scale
+        float y = area.getBottom() - FastMath::log1p(mags[i]) * 20.0f; // log scale
         p.lineTo(x, juce::jmax(area.getY(), y));
     }
     g.strokePath(p, juce::PathStrokeType(1.5f));
@@ -198,7 +199,7 @@ void SpectralDisplay::updateSpectrogram()
         for (int y = 0; y < h; ++y)
         {
             const int bin = juce::jmap(y, 0, h - 1, (int)mags.size() - 1, 0);
-            const float v = std::log1p(mags[(size_t)bin]);
+            const float v = FastMath::log1p(mags[(size_t)bin]);
             const float t = juce::jlimit(0.0f, 1.0f, v * 0.05f);
             juce::Colour c = colorGradient.getColourAtPosition(t);
             auto existing = data.getPixelColour(x, y).withAlpha(decayRate);
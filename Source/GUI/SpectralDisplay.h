@@ -37,6 +37,9 @@ public:
     void mouseDrag(const juce::MouseEvent& event) override;
     void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
 
+    // Scrolls in one spectrogram column from the analyzer's current magnitudes (timer-driven at 30 Hz)
+    void updateSpectrogram();
+
 private:
     SpectralAnalyzer& spectralAnalyzer;
     juce::AudioProcessorValueTreeState& parameters;
@@ -63,7 +66,6 @@ private:
     void drawFormantAnalysis(juce::Graphics& g);
     void drawRealTimeFFT(juce::Graphics& g);
 
-    void updateSpectrogram();
     void handleRegionClick(const juce::Point<int>& position);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralDisplay)
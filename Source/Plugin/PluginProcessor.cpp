@@ -5,187 +5,410 @@
 // File: PluginProcessor.cpp
 // Description: Implements TitanVocal AudioProcessor with DSP chain and AI buffered processing.
 #include "PluginProcessor.h"
+#if ! TITANVOCAL_HEADLESS
 #include "../GUI/PluginEditor.h"
+#endif
 
 TitanVocalProcessor::TitanVocalProcessor()
     : juce::AudioProcessor(BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true)
                                               .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
-    // Default latency to frame size when AI is enabled (updated in prepareToPlay)
+    updateWarmupSizes();
+
+    const auto modelsDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory().getChildFile("Resources").getChildFile("Models");
+    for (const auto* name : { "default.onnx", "default.pt" })
+    {
+        if (modelsDir.getChildFile(name).existsAsFile())
+        {
+            defaultModelPath = modelsDir.getChildFile(name).getFullPathName();
+            break;
+        }
+    }
+
+    // Publishes latency changes made on the audio thread to the host
+    startTimerHz(10);
 }
 
 TitanVocalProcessor::~TitanVocalProcessor() = default;
 
 void TitanVocalProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused(samplesPerBlock);
     currentSampleRate = sampleRate;
+    // Every stage below is sized for one sub-block, never for the host's block
+    subBlockSize = juce::jlimit(1, juce::jmax(1, samplesPerBlock), requestedSubBlockSize);
+    aiOverlap = requestedAIOverlap;
+    spectrumSamplesPending = 0;
+
+    // Per channel: the compensated input, processed, delayed dry, gate gain and AI wet signals,
+    // four channel pointer tables and the gate flags
+    const auto numChannels = (size_t) juce::jlimit(1, maxChannels, juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels()));
+    scratch.prepare(numChannels * 5 * ScratchArena::bytesFor<float>((size_t) subBlockSize)
+                    + 4 * ScratchArena::bytesFor<float*>(numChannels)
+                    + ScratchArena::bytesFor<bool>(numChannels));
+    params.prepare(sampleRate, subBlockSize);
+    telemetry.prepare(sampleRate);
+
+    // Hosts usually switch to non-realtime before re-preparing for a bounce; processBlock follows
+    // a switch made without one
+    offlineMode = isNonRealtime();
+    hostBlockSize = juce::jmax(1, samplesPerBlock);
+
+    channels.clear();
+    for (size_t ch = 0; ch < numChannels; ++ch)
+    {
+        auto state = std::make_unique<ChannelState>();
+        state->pitchShifter.prepare(sampleRate, subBlockSize);
+        state->aiFramer.prepare(maxAIFrameSize);
+        channels.push_back(std::move(state));
+    }
+    formantBank.prepare(sampleRate, (int) numChannels);
+    noiseGate.prepare(sampleRate, (int) numChannels, subBlockSize);
+
+    // The shifter's delay and the gate's lookahead are fixed; the dry path is delayed along with
+    // them. The longest configuration is high quality with AI running, and no configuration
+    // delays the DSP input by more than its whole latency.
+    shifterLatency = channels[0]->pitchShifter.getLatencySamples();
+    gateLatency = noiseGate.getLatencySamples();
+    const int maxLatency = getLatencyFor({ LatencyMode::highQuality, true, AIModelInterface::NOISE_REDUCTION, false });
+    dspInputDelay.prepare((int) numChannels, maxLatency, subBlockSize);
+
+    // AI streams: input ring holds a partial frame (with its context, offline) and one sub-block;
+    // output ring holds everything produced ahead of the latency plus one sub-block. Sized for
+    // either mode, since the host may switch without preparing again.
+    const int maxInputFrameSize = 2 * maxAIFrameSize;
+    for (auto& state : channels)
+    {
+        state->aiInputRing.prepare(maxInputFrameSize + subBlockSize);
+        state->aiOutputRing.prepare(maxLatency + maxAIFrameSize + subBlockSize);
+    }
 
-    juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) samplesPerBlock, (juce::uint32) getTotalNumOutputChannels() };
-    for (int ch = 0; ch < 2; ++ch)
-        for (int i = 0; i < 3; ++i)
-            formantFilters[ch][i].prepare(spec);
-
-    // Initialize AI buffers
-    for (int ch = 0; ch < 2; ++ch) { aiInputDeque[ch].clear(); aiOutputDeque[ch].clear(); }
-    setLatencySamples(aiFrameSize);
-
-    // Attempt to load default model if present based on selected model type
-    auto modelType = getSelectedModelType();
-    juce::File modelsDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory().getChildFile("Resources").getChildFile("Models");
-    juce::File defaultOnnx = modelsDir.getChildFile("default.onnx");
-    juce::File defaultTorch = modelsDir.getChildFile("default.pt");
-    if (defaultOnnx.existsAsFile())
-        aiInterface.loadModel(modelType, defaultOnnx.getFullPathName().toStdString());
-    else if (defaultTorch.existsAsFile())
-        aiInterface.loadModel(modelType, defaultTorch.getFullPathName().toStdString());
+    // Realtime: one worker per extra lane group, leaving a core for the host.
+    // Offline: every core, shared between lane groups and AI frames.
+    const int numGroups = FormantFilterBank::getNumGroups((int) numChannels);
+    const int numCpus = juce::SystemStats::getNumCpus();
+    const int offlineThreads = offlineThreadCount > 0 ? offlineThreadCount : numCpus;
+    if (offlineMode)
+        channelPool.prepare(offlineThreads - 1);
+    else
+        channelPool.prepare(juce::jmin(numGroups - 1, juce::jmax(0, numCpus - 2)), 1000.0 * samplesPerBlock / sampleRate);
+
+    // A hop of input starts a frame, so a channel has a frame in flight per hop of latency and
+    // per hop of the sub-block being pushed
+    const int minHopSize = getAIFramingFor(LatencyMode::lowLatency, true).hopSize;
+    const int jobsPerChannel = (maxLatency + subBlockSize) / minHopSize + 2;
+    inferenceWorker.prepare(maxAIFrameSize, jobsPerChannel * (int) numChannels, (int) numChannels);
+    transportWasPlaying = false;
+    aiWasEnabled = false;
+
+    offlineFrames.clear();
+    offlineFrames.resize(numChannels * (size_t) (samplesPerBlock / minHopSize + 2));
+    for (auto& frame : offlineFrames)
+    {
+        frame.window.reserve((size_t) maxInputFrameSize);
+        frame.processed.reserve((size_t) maxInputFrameSize);
+    }
+    numOfflineFrames = 0;
+
+    // Default model for the selected type (once; hosts and the batch renderer re-prepare often).
+    // Realtime prepares return at once and the model arrives in the background; a bounce waits
+    // for it so that every frame goes through the model.
+    const auto modelType = getCurrentModelType();
+    if (offlineMode && defaultModelPath.isNotEmpty() && ! aiInterface.isModelLoaded(modelType))
+        aiInterface.loadModel(modelType, defaultModelPath.toStdString());
+    else
+        requestSelectedModel();
+
+    // Everything is sized and a bounce has its model, whose state decides the framing; set up the
+    // delays for the current parameters and tell the host directly, before the first block
+    applyLatencyConfig(getRequestedConfig());
+    setLatencySamples(activeLatency);
+
+    // A bounce leaves the worker idle on its semaphore, ready in case the host switches back
+    inferenceWorker.startWorker();
 }
 
 void TitanVocalProcessor::releaseResources()
 {
+    inferenceWorker.stopWorker();
+    channelPool.shutdown();
 }
 
 bool TitanVocalProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
+    // Any layout up to maxChannels (mono, stereo, LCR, 5.1 stems, discrete mic beds), same in and out
     const auto& out = layouts.getMainOutputChannelSet();
     const auto& in = layouts.getMainInputChannelSet();
-    if (out != juce::AudioChannelSet::mono() && out != juce::AudioChannelSet::stereo())
+    if (out.size() < 1 || out.size() > maxChannels)
         return false;
     if (out != in) return false;
     return true;
 }
 
-void TitanVocalProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+void TitanVocalProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
-    juce::ignoreUnused(midi);
+    TITANVOCAL_RT_SCOPE();
     juce::ScopedNoDenormals noDenormals;
+    telemetry.beginBlock(buffer.getNumSamples());
+
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    auto* dryWetParam = apvts.getRawParameterValue("dryWet");
-    auto* outputGainParam = apvts.getRawParameterValue("outputGain");
+    if (isNonRealtime() != offlineMode)
+        switchOfflineMode(isNonRealtime());
+    checkTransportDiscontinuity(buffer.getNumSamples());
 
-    const float dryWet = dryWetParam ? dryWetParam->load() : 1.0f;
-    const float gainDb = outputGainParam ? outputGainParam->load() : 0.0f;
-    const float pitchAmt = apvts.getRawParameterValue("pitchAmount") ? apvts.getRawParameterValue("pitchAmount")->load() : 0.0f;
-    const float formShift = apvts.getRawParameterValue("formantShift") ? apvts.getRawParameterValue("formantShift")->load() : 0.0f;
-    const float noiseAmt = apvts.getRawParameterValue("noiseAmount") ? apvts.getRawParameterValue("noiseAmount")->load() : 0.0f;
-    const float satAmt = apvts.getRawParameterValue("saturation") ? apvts.getRawParameterValue("saturation")->load() : 0.0f;
-    const bool aiEnabled = apvts.getRawParameterValue("aiEnabled") ? (apvts.getRawParameterValue("aiEnabled")->load() > 0.5f) : false;
-    const float gain = juce::Decibels::decibelsToGain(gainDb);
+    // Whatever the host sends is cut into sub-blocks of at most subBlockSize. Parameters are
+    // re-read and ramps and formant coefficients advance once per sub-block, and no stage ever
+    // sees a longer block than it was sized for. A host split at an automation point simply
+    // gives a shorter last sub-block.
+    for (int start = 0; start < buffer.getNumSamples(); start += subBlockSize)
+    {
+        juce::AudioBuffer<float> slice (buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                        start, juce::jmin(subBlockSize, buffer.getNumSamples() - start));
+        processSubBlock(slice);
+    }
 
-    // Update formant filters per block
-    updateFormantFilters(formShift);
+    // Offline: run any AI frames the sub-blocks queued but did not need yet
+    if (numOfflineFrames > 0)
+        runOfflineBatch();
 
-    // Process per channel: naive pitch shift, formant filters, noise gate, saturation
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    // The analyzer FFT runs once per hop of audio rather than once per call, so its cost per
+    // sample is the same for 16- and 8192-sample host blocks
+    spectrumSamplesPending += buffer.getNumSamples();
+    if (spectrumSamplesPending >= spectrumHop)
     {
-        auto* data = buffer.getWritePointer(ch);
-        spectralAnalyzer.pushAudioBuffer(data, buffer.getNumSamples());
+        enterStage(ProcessingStage::spectrum);
+        spectralAnalyzer.computeSpectrum();
+        spectrumSamplesPending %= spectrumHop;
+    }
+    telemetry.endBlock();
+}
+
+void TitanVocalProcessor::processSubBlock(juce::AudioBuffer<float>& buffer)
+{
+    enterStage(ProcessingStage::setup);
+    scratch.reset();
+    params.update(buffer.getNumSamples());
+    const float* dryWetRamp = params.getRamp(ParamIndex::dryWet);
+    const float* gainRamp = params.getRamp(ParamIndex::outputGain);
+    const float* satRamp = params.getRamp(ParamIndex::saturation);
+    const float pitchAmt = params.get(ParamIndex::pitchAmount);
+    const float formShift = params.get(ParamIndex::formantShift);
+    const float noiseAmt = params.get(ParamIndex::noiseAmount);
+    const float satAmt = params.get(ParamIndex::saturation);
+
+    // Latency mode, AI on/off and the model decide the chain's delays; follow any change first
+    const auto requestedConfig = getRequestedConfig();
+    if (requestedConfig != activeConfig)
+        applyLatencyConfig(requestedConfig);
+    const bool aiEnabled = activeConfig.aiActive;
+
+    // Formant coefficients are only rebuilt when the shift moves, and glide across this block
+    formantBank.setShift(formShift, buffer.getNumSamples());
+
+    if (aiEnabled)
+    {
+        if (! aiWasEnabled || aiResyncPending)
+            resetAIStreams();
+        collectAIResults();
+    }
+    aiWasEnabled = aiEnabled;
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), (int) channels.size());
+    const int numSamples = buffer.getNumSamples();
+
+    const float maxSemis = 12.0f;
+    const float semis = juce::jlimit(-maxSemis, maxSemis, (pitchAmt - 0.5f) * 2.0f * maxSemis); // map 0..1 to -12..+12
+
+    // noiseAmount drives the gate from the default threshold/reduction settings
+    QuantumParameters::NoiseParams noiseSettings;
+    noiseSettings.amount = noiseAmt;
+    noiseGate.setParameters(noiseSettings);
+
+    // Scratch signals per channel: pitch-shifted wet, dry delayed to match, and gate gain
+    auto& task = groupTask;
+    task.input = buffer.getArrayOfReadPointers();
+    task.delayedInput = scratch.allocate<float*>((size_t) numChannels);
+    task.processed = scratch.allocate<float*>((size_t) numChannels);
+    task.dry = scratch.allocate<float*>((size_t) numChannels);
+    task.gateGain = scratch.allocate<float*>((size_t) numChannels);
+    task.gateActive = scratch.allocate<bool>((size_t) numChannels);
+    task.numChannels = numChannels;
+    task.numSamples = numSamples;
+    task.pitchRatio = FastMath::semitonesToRatio(semis);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        enterStage(ProcessingStage::analyzerPush);
+        spectralAnalyzer.pushAudioBuffer(buffer.getReadPointer(ch), numSamples);
+
+        task.delayedInput[ch] = scratch.allocate<float>((size_t) numSamples);
+        task.processed[ch] = scratch.allocate<float>((size_t) numSamples);
+        task.dry[ch] = scratch.allocate<float>((size_t) numSamples);
+        task.gateGain[ch] = scratch.allocate<float>((size_t) numSamples);
+    }
 
-        // Copy dry signal
-        std::vector<float> processed(buffer.getNumSamples());
+    // Pitch, formant and gate per lane group; groups share no state, so wide layouts spread them
+    // over the channel pool once the block is long enough to repay the hand-off
+    const int numGroups = FormantFilterBank::getNumGroups(numChannels);
+    telemetry.suspend();
+    if (offlineMode || numSamples >= minParallelBlockSize)
+        channelPool.run([](void* context, int group) { static_cast<TitanVocalProcessor*>(context)->processChannelGroup(group); },
+                        this, numGroups);
+    else
+        for (int group = 0; group < numGroups; ++group)
+            processChannelGroup(group);
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        telemetry.add(ProcessingStage::pitch, task.stageTicks[group][0]);
+        telemetry.add(ProcessingStage::formant, task.stageTicks[group][1]);
+        telemetry.add(ProcessingStage::gate, task.stageTicks[group][2]);
+    }
 
-        // Naive pitch shift by resampling with ratio up to +/- 12 semitones (one octave)
-        const float maxSemis = 12.0f;
-        const float semis = juce::jlimit(-maxSemis, maxSemis, (pitchAmt - 0.5f) * 2.0f * maxSemis); // map 0..1 to -12..+12
-        const float ratio = std::pow(2.0f, semis / 12.0f);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+    enterStage(ProcessingStage::formant);
+    formantBank.advance(numSamples);
+    dspInputDelay.advance(numSamples);
+
+    // If AI enabled, feed input into the AI streams and hand off full frames
+    enterStage(ProcessingStage::aiPush);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* data = buffer.getReadPointer(ch);
+        auto& aiInput = channels[(size_t) ch]->aiInputRing;
+        auto& aiOutput = channels[(size_t) ch]->aiOutputRing;
+        if (aiEnabled && offlineMode)
         {
-            float srcIndex = (float) i / ratio;
-            if (srcIndex <= 0.0f) processed[i] = data[0];
-            else if (srcIndex >= buffer.getNumSamples() - 1)
-                processed[i] = data[buffer.getNumSamples() - 1];
-            else
+            queueOfflineFrames(ch, data, numSamples);
+        }
+        else if (aiEnabled)
+        {
+            // Push input samples in bulk, draining full frames whenever the ring fills up
+            int pushed = 0;
+            while (pushed < numSamples && ! aiResyncPending)
             {
-                int idx = (int) srcIndex;
-                float frac = srcIndex - (float) idx;
-                processed[i] = juce::jmap(frac, data[idx], data[idx + 1]);
+                pushed += aiInput.write(data + pushed, numSamples - pushed);
+
+                // Hand each frame to the inference worker as its last hop arrives
+                auto& framer = channels[(size_t) ch]->aiFramer;
+                while (aiInput.getNumReady() >= aiFraming.frameSize)
+                {
+                    auto* job = inferenceWorker.acquireJob();
+                    if (job == nullptr)
+                    {
+                        // Worker has fallen a whole pool behind: restart the stream next block
+                        aiMissedFrames.fetch_add(1, std::memory_order_relaxed);
+                        aiResyncPending = true;
+                        break;
+                    }
+
+                    job->input.resize((size_t) aiFraming.frameSize);
+                    job->output.resize((size_t) aiFraming.frameSize);
+                    aiInput.peek(job->input.data(), aiFraming.frameSize);
+                    aiInput.discard(aiFraming.hopSize);
+                    framer.applyAnalysisWindow(job->input.data());
+                    job->channel = ch;
+                    job->generation = aiGeneration;
+                    job->modelType = getSelectedModelType();
+                    job->pitchAmount = pitchAmt;
+                    job->formantShift = formShift;
+                    job->noiseAmount = noiseAmt;
+                    job->saturation = satAmt;
+                    job->resetState = std::exchange(channels[(size_t) ch]->aiStateResetPending, false);
+                    inferenceWorker.submit(job);
+                }
             }
         }
-
-        // Formant filters
-        juce::AudioBuffer<float> tempBuffer (1, (int) processed.size());
-        tempBuffer.copyFrom(0, 0, processed.data(), (int) processed.size());
-        juce::dsp::AudioBlock<float> block (tempBuffer);
-        juce::dsp::ProcessContextReplacing<float> ctx (block);
-        for (int i = 0; i < 3; ++i)
-            formantFilters[juce::jmin(ch, 1)][i].process(ctx);
-        const float* procPtr = tempBuffer.getReadPointer(0);
-        std::copy(procPtr, procPtr + tempBuffer.getNumSamples(), processed.begin());
-
-        // Noise gate (simple): threshold scales with noiseAmt
-        const float baseThresh = 0.02f; // base threshold
-        const float threshold = baseThresh * (1.0f - noiseAmt); // more reduction => higher attenuation below threshold
-        const float attenuation = juce::jmap(noiseAmt, 0.0f, 1.0f, 1.0f, 0.2f);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        else
         {
-            if (std::abs(processed[i]) < threshold)
-                processed[i] *= attenuation;
+            // Drop stale frames so re-enabling AI starts from fresh audio
+            aiInput.discard(aiInput.getNumReady());
+            aiOutput.discard(aiOutput.getNumReady());
         }
+    }
 
-        // Saturation: mix between linear and tanh
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+    // Queued offline frames take the latest settings; the batch runs once the output needs it
+    if (numOfflineFrames > 0)
+    {
+        offlineModel = getSelectedModelType();
+        offlineParams.pitchAmount = pitchAmt;
+        offlineParams.formantShift = formShift;
+        offlineParams.noiseAmount = noiseAmt;
+        offlineParams.saturation = satAmt;
+    }
+
+    // Saturation only runs when it can change the signal this block
+    OutputStage::Controls outputControls;
+    outputControls.saturation = satRamp;
+    outputControls.dryWet = dryWetRamp;
+    outputControls.gain = gainRamp;
+    const bool saturationActive = satAmt > 0.0f || params.isSmoothing(ParamIndex::saturation);
+
+    // Per channel: one fused pass for gate, saturation, mix and gain
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* data = buffer.getWritePointer(ch);
+        auto& state = *channels[(size_t) ch];
+        auto& aiOutput = state.aiOutputRing;
+        const float* processed = task.processed[ch];
+        const float* dry = task.dry[ch];
+        float* aiWet = scratch.allocate<float>((size_t) numSamples);
+        const bool gateActive = task.gateActive[ch];
+        outputControls.gateGain = task.gateGain[ch];
+
+        // If AI output available, use it as wet signal; otherwise fall back to processed chain.
+        // The first latency's worth of samples after (re)starting AI is always the DSP chain.
+        enterStage(ProcessingStage::aiPop);
+        const int numPrimed = aiEnabled ? juce::jmin(state.aiPrimeSamples, numSamples) : 0;
+        state.aiPrimeSamples -= numPrimed;
+        if (numOfflineFrames > 0 && aiOutput.getNumReady() < numSamples - numPrimed)
+            runOfflineBatch();
+        const int numAI = aiEnabled ? aiOutput.read(aiWet + numPrimed, numSamples - numPrimed) : 0;
+        jassert(! aiEnabled || ! offlineMode || numPrimed + numAI == numSamples);
+        if (aiEnabled && numPrimed + numAI < numSamples)
         {
-            float x = processed[i];
-            float y = std::tanh(x);
-            processed[i] = (1.0f - satAmt) * x + satAmt * y;
+            if (state.aiLateSamples == 0)
+                aiMissedFrames.fetch_add(1, std::memory_order_relaxed);
+            state.aiLateSamples += numSamples - numPrimed - numAI;
         }
 
-        // If AI enabled, feed input into AI buffer and produce output frames
-        if (aiEnabled)
+        // Samples [numPrimed, numPrimed + numAI) take the AI stream as wet, the rest the DSP chain
+        enterStage(ProcessingStage::mix);
+        if (aiEnabled && ! isShifterCompensated(activeConfig))
         {
-            // Push input samples
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-                aiInputDeque[juce::jmin(ch, 1)].push_back(data[i]);
-
-            // Process full frames
-            while ((int) aiInputDeque[juce::jmin(ch, 1)].size() >= aiFrameSize)
-            {
-                std::vector<float> frame;
-                frame.reserve(aiFrameSize);
-                for (int i = 0; i < aiFrameSize; ++i) { frame.push_back(aiInputDeque[juce::jmin(ch, 1)].front()); aiInputDeque[juce::jmin(ch, 1)].pop_front(); }
-
-                std::map<std::string, float> aiParams {
-                    { "pitchAmount", pitchAmt },
-                    { "formantShift", formShift },
-                    { "noiseAmount", noiseAmt },
-                    { "saturation", satAmt },
-                };
-                auto result = aiInterface.processFrame(getSelectedModelType(), frame, aiParams);
-                const auto& out = result.success && !result.processedAudio.empty() ? result.processedAudio : frame;
-                for (auto v : out) aiOutputDeque[juce::jmin(ch, 1)].push_back(v);
-            }
+            // The DSP wet lags the dry by the shifter's window here, so the rest take the dry
+            // signal, which is on the latency, and the AI stream fades in from it where it resumes
+            if (numPrimed > 0)
+                state.aiFadeInPosition = 0;
+            for (int i = numPrimed; i < numPrimed + numAI && state.aiFadeInPosition < aiFadeInLength; ++i, ++state.aiFadeInPosition)
+                aiWet[i] = dry[i] + (aiWet[i] - dry[i]) * ((float) state.aiFadeInPosition / (float) aiFadeInLength);
+            if (numPrimed + numAI < numSamples)
+                state.aiFadeInPosition = 0;
+
+            OutputStage::processExternalWet(dry, dry, data, outputControls, 0, numPrimed);
+            OutputStage::processExternalWet(aiWet, dry, data, outputControls, numPrimed, numPrimed + numAI);
+            OutputStage::processExternalWet(dry, dry, data, outputControls, numPrimed + numAI, numSamples);
         }
-
-        // Mix and gain
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        else
         {
-            float dry = data[i];
-            float wet = processed[i];
-            if (aiEnabled)
-            {
-                // If AI output available, use it as wet signal; otherwise fall back to processed chain
-                if (!aiOutputDeque[juce::jmin(ch, 1)].empty())
-                {
-                    wet = aiOutputDeque[juce::jmin(ch, 1)].front();
-                    aiOutputDeque[juce::jmin(ch, 1)].pop_front();
-                }
-            }
-            data[i] = (1.0f - dryWet) * dry + dryWet * wet;
-            data[i] *= gain;
+            OutputStage::processDsp(gateActive, saturationActive, processed, dry, data, outputControls, 0, numPrimed);
+            OutputStage::processExternalWet(aiWet, dry, data, outputControls, numPrimed, numPrimed + numAI);
+            OutputStage::processDsp(gateActive, saturationActive, processed, dry, data, outputControls, numPrimed + numAI, numSamples);
         }
     }
-    spectralAnalyzer.computeSpectrum();
 }
 
 juce::AudioProcessorEditor* TitanVocalProcessor::createEditor()
 {
+   #if TITANVOCAL_HEADLESS
+    return nullptr;
+   #else
     return new TitanVocalEditor(*this);
+   #endif
 }
 
 void TitanVocalProcessor::getStateInformation(juce::MemoryBlock& destData)
@@ -205,53 +428,375 @@ void TitanVocalProcessor::setStateInformation(const void* data, int sizeInBytes)
     }
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout TitanVocalProcessor::createParameterLayout()
+bool TitanVocalProcessor::applyPreset(const juce::XmlElement& xml)
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    // Simple <Parameters><Parameter id="..." value="..."/></Parameters> format, plain values
+    if (xml.hasTagName("Parameters"))
+    {
+        for (auto* child : xml.getChildWithTagNameIterator("Parameter"))
+        {
+            if (auto* p = apvts.getParameter(child->getStringAttribute("id")))
+                p->setValueNotifyingHost(p->convertTo0to1((float) child->getDoubleAttribute("value")));
+        }
+        return true;
+    }
 
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("dryWet", "Dry/Wet", juce::NormalisableRange<float>(0.0f, 1.0f), 1.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("outputGain", "Output Gain", juce::NormalisableRange<float>(-24.0f, 24.0f), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("pitchAmount", "Pitch Amount", juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("pitchSpeed", "Pitch Speed", juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("formantShift", "Formant Shift", juce::NormalisableRange<float>(-12.0f, 12.0f), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("noiseAmount", "Noise Reduction", juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
-    params.push_back(std::make_unique<juce::AudioParameterFloat>("saturation", "Saturation", juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
+    // Full state as written by getStateInformation
+    if (xml.hasTagName(apvts.state.getType()))
+    {
+        apvts.replaceState(juce::ValueTree::fromXml(xml));
+        return true;
+    }
+    return false;
+}
 
-    // AI toggle (0: off, 1: on)
-    params.push_back(std::make_unique<juce::AudioParameterBool>("aiEnabled", "AI Enabled", false));
+juce::AudioProcessorValueTreeState::ParameterLayout TitanVocalProcessor::createParameterLayout()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
 
-    // AI model selection
-    juce::StringArray modelChoices { "Noise Reduction", "Pitch Correction", "Formant Repair", "Breath Control", "Voice Morphing", "Timing Correction" };
-    params.push_back(std::make_unique<juce::AudioParameterChoice>("aiModelType", "AI Model", modelChoices, 0));
+    for (const auto& spec : parameterTable)
+    {
+        switch (spec.kind)
+        {
+            case ParameterSpec::Kind::continuous:
+                params.push_back(std::make_unique<juce::AudioParameterFloat>(spec.id, spec.name,
+                                     juce::NormalisableRange<float>(spec.minValue, spec.maxValue), spec.defaultValue));
+                break;
+            case ParameterSpec::Kind::toggle:
+                params.push_back(std::make_unique<juce::AudioParameterBool>(spec.id, spec.name, spec.defaultValue > 0.5f));
+                break;
+            case ParameterSpec::Kind::choice:
+            {
+                juce::StringArray choices;
+                if (spec.index == ParamIndex::latencyMode)
+                    for (auto* choiceName : latencyModeChoiceNames)
+                        choices.add(choiceName);
+                else
+                    for (auto* choiceName : aiModelChoiceNames)
+                        choices.add(choiceName);
+                params.push_back(std::make_unique<juce::AudioParameterChoice>(spec.id, spec.name, choices, (int) spec.defaultValue));
+                break;
+            }
+        }
+    }
 
     return { params.begin(), params.end() };
 }
 
 // JUCE plugin entry point factory is defined in CreateFilter.cpp
 
-void TitanVocalProcessor::updateFormantFilters(float semitoneShift)
+void TitanVocalProcessor::resetAIStreams()
+{
+    // Results still in flight from an earlier run are dropped via the generation tag
+    ++aiGeneration;
+    aiResyncPending = false;
+    for (auto& state : channels)
+    {
+        state->aiInputRing.discard(state->aiInputRing.getNumReady());
+        state->aiOutputRing.discard(state->aiOutputRing.getNumReady());
+        state->aiPrimeSamples = activeLatency;
+        state->aiLateSamples = 0;
+        state->aiStateResetPending = true;
+        state->offlineStream.reset();
+
+        // The first frame is due one hop in, with silence before the stream in its other hops and
+        // in the history an offline frame is sent with
+        state->aiFramer.reset();
+        state->aiInputRing.fill(0.0f, state->aiFramer.getLeadInSamples() + offlineContext);
+    }
+    numOfflineFrames = 0;
+}
+
+void TitanVocalProcessor::writeAIFrame(ChannelState& state, const float* frame)
 {
-    // Base formant centers (Hz)
-    const float F1 = 500.0f;
-    const float F2 = 1500.0f;
-    const float F3 = 2500.0f;
-    const float Q = 1.0f; // broad peaking filters
+    int numFinished = 0;
+    const float* finished = state.aiFramer.addFrame(frame, numFinished);
 
-    auto shifted = [&](float f){ return f * std::pow(2.0f, semitoneShift / 12.0f); };
+    // Skip the part of the finished samples whose slot was already filled by the DSP fallback
+    const int skip = juce::jmin(state.aiLateSamples, numFinished);
+    state.aiLateSamples -= skip;
+    state.aiOutputRing.write(finished + skip, numFinished - skip);
+}
+
+void TitanVocalProcessor::collectAIResults()
+{
+    while (auto* job = inferenceWorker.popCompleted())
+    {
+        // Jobs come back in submission order, so each channel's frames are added in stream order.
+        // A failed frame adds its windowed input, which overlap-adds back to the unprocessed audio.
+        if (job->generation == aiGeneration && job->channel < (int) channels.size())
+            writeAIFrame(*channels[(size_t) job->channel], job->success ? job->output.data() : job->input.data());
+        inferenceWorker.release(job);
+    }
+}
+
+void TitanVocalProcessor::processChannelGroup(int group)
+{
+    const auto& task = groupTask;
+    const int first = group * FormantFilterBank::lanes;
+    const int numActive = juce::jmin(FormantFilterBank::lanes, task.numChannels - first);
+    auto& ticks = groupTask.stageTicks[group];
+    const auto pitchStart = StageTelemetry::now();
+
+    // Streaming pitch shift, +/- 12 semitones (one octave) across the pitchAmount range. While AI
+    // runs with a longer latency than the chain, the input is delayed first to line up with it.
+    TITANVOCAL_RT_STAGE(ProcessingStage::pitch);
+    for (int ch = first; ch < first + numActive; ++ch)
+    {
+        auto& shifter = channels[(size_t) ch]->pitchShifter;
+        shifter.setRatio(task.pitchRatio);
+        const float* input = dspInputDelay.process(ch, task.input[ch], task.delayedInput[ch], task.numSamples);
+        shifter.process(input, task.processed[ch], task.dry[ch], task.numSamples);
+    }
+
+    // Formant peaks on this group's lanes
+    TITANVOCAL_RT_STAGE(ProcessingStage::formant);
+    const auto formantStart = StageTelemetry::now();
+    formantBank.processGroup(group, task.processed + first, numActive, task.numSamples);
+
+    // Lookahead delay on wet and dry alike; the gain is applied in the output pass
+    TITANVOCAL_RT_STAGE(ProcessingStage::gate);
+    const auto gateStart = StageTelemetry::now();
+    for (int ch = first; ch < first + numActive; ++ch)
+        task.gateActive[ch] = noiseGate.process(ch, task.processed[ch], task.dry[ch], task.gateGain[ch], task.numSamples);
+
+    ticks = { formantStart - pitchStart, gateStart - formantStart, StageTelemetry::now() - gateStart };
+}
+
+void TitanVocalProcessor::queueOfflineFrames(int channel, const float* input, int numSamples)
+{
+    auto& state = *channels[(size_t) channel];
+    state.aiInputRing.write(input, numSamples);
+
+    // One frame per hop as on the realtime path, once the frame and its lookahead have arrived.
+    // The ring starts offlineContext samples before the frame, so that is the history.
+    const int windowSize = aiFraming.frameSize + 2 * offlineContext;
+    while (state.aiInputRing.getNumReady() >= windowSize)
+    {
+        // Hosts may exceed the block size they announced; run what is queued rather than overflow
+        if (numOfflineFrames == (int) offlineFrames.size())
+            runOfflineBatch();
+        auto& frame = offlineFrames[(size_t) numOfflineFrames++];
+        frame.channel = channel;
+
+        state.aiInputRing.peek(frame.window.data(), windowSize);
+        state.aiInputRing.discard(aiFraming.hopSize);
+    }
+}
 
-    for (int ch = 0; ch < 2; ++ch)
+void TitanVocalProcessor::runOfflineBatch()
+{
+    if (offlineStateful)
+        channelPool.run([](void* context, int channel) { static_cast<TitanVocalProcessor*>(context)->processOfflineChannel(channel); },
+                        this, (int) channels.size());
+    else
+        channelPool.run([](void* context, int index) { static_cast<TitanVocalProcessor*>(context)->processOfflineFrame(index); },
+                        this, numOfflineFrames);
+
+    // Frames were queued in stream order per channel, so adding them in turn keeps each stream in
+    // order. The model saw the frame unwindowed, so its centre takes the analysis window here and
+    // the synthesis window as it is added. A failed frame passes its input through, as on the
+    // realtime path.
+    for (int i = 0; i < numOfflineFrames; ++i)
     {
-        formantFilters[ch][0].coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(currentSampleRate, shifted(F1), Q, 1.5f);
-        formantFilters[ch][1].coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(currentSampleRate, shifted(F2), Q, 1.5f);
-        formantFilters[ch][2].coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(currentSampleRate, shifted(F3), Q, 1.3f);
+        auto& frame = offlineFrames[(size_t) i];
+        auto& state = *channels[(size_t) frame.channel];
+        float* centre = (frame.success ? frame.processed.data() : frame.window.data()) + offlineContext;
+        state.aiFramer.applyAnalysisWindow(centre);
+        writeAIFrame(state, centre);
     }
+    numOfflineFrames = 0;
+}
+
+void TitanVocalProcessor::processOfflineFrame(int index)
+{
+    auto& frame = offlineFrames[(size_t) index];
+    auto* stream = offlineStateful ? &channels[(size_t) frame.channel]->offlineStream : nullptr;
+    frame.success = aiInterface.processFrame(offlineModel, frame.window.data(), (int) frame.window.size(),
+                                             offlineParams, frame.processed.data(), stream);
+}
+
+void TitanVocalProcessor::processOfflineChannel(int channel)
+{
+    // Frames were queued in stream order, so the channel's state follows its audio
+    for (int i = 0; i < numOfflineFrames; ++i)
+        if (offlineFrames[(size_t) i].channel == channel)
+            processOfflineFrame(i);
+}
+
+void TitanVocalProcessor::switchOfflineMode(bool shouldBeOffline)
+{
+    // Audio thread. Both modes were sized for at prepareToPlay and report the same latency, so
+    // this only restarts the AI streams (dropping frames in flight or queued) with the other
+    // framing. A bounce started this way does not wait for a model still loading, nor get every
+    // core for its frames.
+    offlineMode = shouldBeOffline;
+    applyLatencyConfig(activeConfig);
+}
+
+void TitanVocalProcessor::checkTransportDiscontinuity(int numSamples)
+{
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return;
+    const auto position = playHead->getPosition();
+    if (! position.hasValue())
+        return;
+
+    const bool playing = position->getIsPlaying();
+    const auto time = position->getTimeInSamples();
+    const bool jumped = playing && (! transportWasPlaying || (time.hasValue() && *time != expectedTransportSample));
+    transportWasPlaying = playing;
+    expectedTransportSample = time.hasValue() ? *time + numSamples : -1;
+    if (! jumped)
+        return;
+
+    // Frames already queued offline belong to the audio before the jump
+    if (numOfflineFrames > 0)
+        runOfflineBatch();
+    for (auto& state : channels)
+    {
+        state->aiStateResetPending = true;
+        state->offlineStream.reset();
+    }
+}
+
+TitanVocalProcessor::LatencyConfig TitanVocalProcessor::getRequestedConfig() const
+{
+    LatencyConfig config;
+    config.mode = (LatencyMode) juce::jlimit(0, 2, params.getChoice(ParamIndex::latencyMode));
+    config.model = getSelectedModelType();
+    // AI (and its latency) starts once a model for this type has been published; until then, and
+    // for good if none loads, the DSP chain is the wet signal
+    config.aiActive = params.getBool(ParamIndex::aiEnabled) && config.mode != LatencyMode::zeroLatency
+                      && aiInterface.isModelLoaded(config.model);
+    config.stateful = config.aiActive && aiInterface.isModelStateful(config.model);
+    config.modelInputSize = config.aiActive ? aiInterface.getModelInputSize(config.model) : 0;
+    return config;
+}
+
+TitanVocalProcessor::AIFraming TitanVocalProcessor::getAIFramingFor(LatencyMode mode, bool stateful) const
+{
+    const int frameSize = mode == LatencyMode::lowLatency ? 256 : maxAIFrameSize;
+    const int hopSize = frameSize / aiOverlap;
+    return stateful ? AIFraming { hopSize, hopSize } : AIFraming { frameSize, hopSize };
+}
+
+int TitanVocalProcessor::getDspLatencyFor(const LatencyConfig& config) const
+{
+    if (config.mode == LatencyMode::zeroLatency)
+        return 0;
+    return gateLatency + (isShifterCompensated(config) ? shifterLatency : 0);
+}
+
+int TitanVocalProcessor::getLatencyFor(const LatencyConfig& config) const
+{
+    // Zero latency compensates nothing. Otherwise the chain's own delay, raised while AI runs to
+    // the frame a sample has to wait for (its last one ends up to a frame later) plus the time the
+    // worker has to return it in. A host callback runs its sub-blocks back to back, so a frame
+    // completed by the callback's first sample is only collected by a later callback: with at least
+    // a host block on top of the frame, every frame gets one whole callback period, whatever the
+    // block and hop. A bounce runs its frames before the block returns, but has to wait for their
+    // lookahead. Both paths report the larger of the two, so a bounce lands on the same samples as
+    // playback prepared with the same block size.
+    const int dspLatency = getDspLatencyFor(config);
+    if (config.mode == LatencyMode::zeroLatency || ! config.aiActive)
+        return dspLatency;
+    const auto framing = getAIFramingFor(config.mode, config.stateful);
+    const int realtimeTurnaround = juce::jmax(framing.hopSize, hostBlockSize);
+    const int offlineLookahead = getOfflineContextFor(framing, config);
+    return juce::jmax(framing.frameSize + juce::jmax(realtimeTurnaround, offlineLookahead), dspLatency);
+}
+
+void TitanVocalProcessor::setAIOverlap(int overlap)
+{
+    requestedAIOverlap = juce::nextPowerOfTwo(juce::jlimit(1, 8, overlap));
+    updateWarmupSizes();
+}
+
+void TitanVocalProcessor::updateWarmupSizes()
+{
+    // Models are warmed up at every frame length the inference worker will send them: each mode's
+    // frame, and its hop for stateful models
+    const int overlap = requestedAIOverlap;
+    std::vector<int> frameSizes;
+    for (const int frameSize : { maxAIFrameSize, getAIFramingFor(LatencyMode::lowLatency, false).frameSize })
+        for (const int size : { frameSize, frameSize / overlap })
+            if (std::find(frameSizes.begin(), frameSizes.end(), size) == frameSizes.end())
+                frameSizes.push_back(size);
+    aiInterface.setWarmup(8, frameSizes);
+}
+
+void TitanVocalProcessor::applyLatencyConfig(const LatencyConfig& config)
+{
+    // Audio thread (or prepareToPlay): only flags, delay lengths and resizes within capacity
+    const bool compensateShifter = isShifterCompensated(config);
+    for (auto& state : channels)
+        state->pitchShifter.setLatencyCompensated(compensateShifter);
+    noiseGate.setLookaheadEnabled(config.mode != LatencyMode::zeroLatency);
+
+    activeConfig = config;
+    activeLatency = getLatencyFor(config);
+    dspInputDelay.setDelay(config.aiActive ? activeLatency - getDspLatencyFor(config) : 0);
+
+    // Offline output is finished once a frame and its lookahead have arrived, realtime output
+    // once the worker has had a callback period for it; the latency covers both, in either mode
+    aiFraming = getAIFramingFor(config.mode, config.stateful);
+    offlineStateful = offlineMode && config.stateful;
+    offlineContext = offlineMode ? getOfflineContextFor(aiFraming, config) : 0;
+    jassert(! config.aiActive || aiFraming.frameSize + getOfflineContextFor(aiFraming, config) <= activeLatency);
+    jassert(! config.aiActive || aiFraming.frameSize + juce::jmax(aiFraming.hopSize, hostBlockSize) <= activeLatency);
+    for (auto& state : channels)
+        state->aiFramer.setFraming(aiFraming.frameSize, aiFraming.hopSize);
+    for (auto& frame : offlineFrames)
+    {
+        frame.window.resize((size_t) (aiFraming.frameSize + 2 * offlineContext));
+        frame.processed.resize((size_t) (aiFraming.frameSize + 2 * offlineContext));
+    }
+
+    // Frames of the old length or model still in flight are dropped by the restart
+    aiResyncPending = true;
+    reportedLatency.store(activeLatency, std::memory_order_relaxed);
+}
+
+void TitanVocalProcessor::timerCallback()
+{
+    // Hosts expect latency changes on the message thread, so the audio thread only publishes them
+    const int latency = reportedLatency.load(std::memory_order_relaxed);
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+
+    // A model type chosen since the last prepare gets its model in the background too
+    requestSelectedModel();
+}
+
+void TitanVocalProcessor::useIdentityModels(bool stateful)
+{
+    defaultModelPath.clear();
+    for (int type = 0; type < AIModelInterface::numModelTypes; ++type)
+        aiInterface.loadIdentityModel((AIModelInterface::ModelType) type, stateful ? 1 : 0);
+}
+
+void TitanVocalProcessor::requestSelectedModel()
+{
+    const auto type = getCurrentModelType();
+    if (defaultModelPath.isNotEmpty() && ! aiInterface.isModelLoaded(type))
+        modelLoader.requestLoad(type, defaultModelPath.toStdString());
 }
 
 AIModelInterface::ModelType TitanVocalProcessor::getSelectedModelType() const
 {
-    int idx = 0;
-    if (auto* p = apvts.getParameter("aiModelType")) idx = p->getValue();
-    switch (idx)
+    return getModelTypeForChoice(params.getChoice(ParamIndex::aiModelType));
+}
+
+AIModelInterface::ModelType TitanVocalProcessor::getCurrentModelType() const
+{
+    return getModelTypeForChoice(juce::roundToInt(params.getCurrent(ParamIndex::aiModelType)));
+}
+
+AIModelInterface::ModelType TitanVocalProcessor::getModelTypeForChoice(int choice)
+{
+    switch (choice)
     {
         case 0: return AIModelInterface::NOISE_REDUCTION;
         case 1: return AIModelInterface::PITCH_CORRECTION;
@@ -8,9 +8,29 @@
 
 #include <JuceHeader.h>
 #include "../DSP/SpectralAnalyzer.h"
+#include "../DSP/FormantFilterBank.h"
+#include "../DSP/PitchShifter.h"
+#include "../DSP/OutputStage.h"
+#include "../DSP/NoiseGate.h"
+#include "../DSP/CompensationDelay.h"
+#include "../DSP/OverlapAddFramer.h"
 #include "../AI/AIModelInterface.h"
+#include "../AI/InferenceWorker.h"
+#include "../AI/ModelLoader.h"
+#include "../Core/SpscRingBuffer.h"
+#include "../Core/ScratchArena.h"
+#include "../Core/RealtimeSanitizer.h"
+#include "../Core/ParameterSnapshot.h"
+#include "../Core/ChannelTaskPool.h"
+#include "../Core/StageTelemetry.h"
 
-class TitanVocalProcessor : public juce::AudioProcessor
+// Headless tools (sanitizer driver, batch renderer) build the processor without the editor
+#ifndef TITANVOCAL_HEADLESS
+ #define TITANVOCAL_HEADLESS 0
+#endif
+
+class TitanVocalProcessor : public juce::AudioProcessor,
+                            private juce::Timer
 {
 public:
     TitanVocalProcessor();
@@ -23,7 +43,7 @@ public:
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
+    bool hasEditor() const override { return ! TITANVOCAL_HEADLESS; }
 
     const juce::String getName() const override { return "TitanVocal"; }
     bool acceptsMidi() const override { return false; }
@@ -40,6 +60,37 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    // Applies a preset in the Resources/Presets format (<Parameters><Parameter id value/>) or a
+    // full saved state. Returns false if the XML is neither.
+    bool applyPreset(const juce::XmlElement& xml);
+
+    // Threads an offline bounce may use, counting the calling thread (0 = every core). Batch
+    // tools that already run one processor per core set this to 1.
+    void setOfflineThreadCount(int numThreads) { offlineThreadCount = juce::jmax(0, numThreads); }
+
+    // AIModelInterface::Precision for models loaded after this call; an FP16 or INT8 sidecar next
+    // to the default model is used when present
+    void setModelPrecision(int precision) { aiInterface.setPrecision(precision); }
+
+    // Threads each inference may use (AIModelInterface::setThreadCount; LibTorch's is per process)
+    void setModelThreadCount(int numThreads) { aiInterface.setThreadCount(numThreads); }
+
+    // Headless checks and benchmarks: every model type runs AIModelInterface's built-in identity
+    // model (stateful if asked) instead of the default model file. Call before prepareToPlay.
+    void useIdentityModels(bool stateful = false);
+
+    // Internal processing granularity, applied at the next prepareToPlay. Smaller sub-blocks follow
+    // automation more closely at a higher fixed cost per sample.
+    static constexpr int defaultSubBlockSize = 64;
+    void setSubBlockSize(int numSamples) { requestedSubBlockSize = juce::jlimit(16, 4096, numSamples); }
+    int getSubBlockSize() const { return subBlockSize; }
+
+    // How many AI frames overlap any one sample (frame / hop: 1, 2, 4 or 8), applied at the next
+    // prepareToPlay. Each step up runs the model twice as often and brings latency closer to one frame.
+    static constexpr int defaultAIOverlap = 4;
+    void setAIOverlap(int overlap);
+    int getAIOverlap() const { return aiOverlap; }
+
     // Parameters
     juce::AudioProcessorValueTreeState apvts;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -47,21 +98,217 @@ public:
     // Analysis
     SpectralAnalyzer spectralAnalyzer;
 
+    // Latency of the configuration the audio thread is running, which the host hears about from the
+    // message thread shortly after a change
+    int getActiveLatencySamples() const { return reportedLatency.load(std::memory_order_relaxed); }
+
+    // Load and warm-up profile of the model for the selected AI model type (message thread)
+    AIModelInterface::ModelConfig getSelectedModelConfig() const { return aiInterface.getModelConfig(getCurrentModelType()); }
+
+    // Number of AI frames that were not back from the inference worker in time
+    int getAIMissedFrames() const { return aiMissedFrames.load(std::memory_order_relaxed); }
+    // Number of callbacks that waited on a lane-group worker for longer than the callback period
+    int getChannelPoolOverruns() const { return channelPool.getNumOverruns(); }
+
+    // Per-block stage timings for the editor's performance view (one reader thread only)
+    int readStageTimings(StageTelemetry::BlockTimings* dest, int maxRecords) { return telemetry.read(dest, maxRecords); }
+
 private:
+    // Cached handles into apvts, read once per block with smoothed ramps for gain-like parameters
+    ParameterSnapshot params { apvts };
+
     AIModelInterface aiInterface;
     double currentSampleRate { 44100.0 };
 
-    // AI buffered processing
-    std::deque<float> aiInputDeque[2];
-    std::deque<float> aiOutputDeque[2];
-    int aiFrameSize { 1024 };
+    // Realtime hosts get the default model from the background loader; the chain runs DSP only
+    // until it is published. Empty when no default model ships next to the binary.
+    ModelLoader modelLoader { aiInterface };
+    juce::String defaultModelPath;
+    void requestSelectedModel();
+
+    // All per-sub-block scratch memory comes from here
+    ScratchArena scratch;
+
+    // processBlock cuts host blocks into sub-blocks of at most this many samples
+    int requestedSubBlockSize { defaultSubBlockSize };
+    int subBlockSize { defaultSubBlockSize };
+    void processSubBlock(juce::AudioBuffer<float>& buffer);
+
+    // The analyzer spectrum is recomputed every spectrumHop samples (half its 2048-point FFT)
+    static constexpr int spectrumHop = 1024;
+    int spectrumSamplesPending { 0 };
+
+    // Widest bus layout accepted; all per-channel state is sized from the actual layout
+    static constexpr int maxChannels = 16;
+
+    // State owned by one channel; the processor holds one per bus channel
+    struct ChannelState
+    {
+        PitchShifter pitchShifter;
+
+        // AI buffered processing (rings are sized in prepareToPlay; no allocation per block)
+        SpscRingBuffer<float> aiInputRing;
+        SpscRingBuffer<float> aiOutputRing;
+        int aiPrimeSamples = 0;
+        int aiLateSamples = 0;
+        bool aiStateResetPending = true;    // the next frame starts a stateful model afresh
+        int aiFadeInPosition = 0;           // AI samples faded in from the dry since the last gap
+        OverlapAddFramer aiFramer;
+
+        // Offline only: the model state
+        AIModelInterface::StreamState offlineStream;
+    };
+    std::vector<std::unique_ptr<ChannelState>> channels;
+
+    // AI frames are cut every hop from the input and overlap-added back (see OverlapAddFramer).
+    // The frame follows the latency mode, the hop the overlap; jobs and rings are sized for the
+    // longest frame and the shortest hop. A stateful model carries its context in its state, so it
+    // is sent each hop once, unwindowed.
+    static constexpr int maxAIFrameSize = 1024;
+    struct AIFraming
+    {
+        int frameSize = maxAIFrameSize;
+        int hopSize = maxAIFrameSize;
+    };
+    int requestedAIOverlap { defaultAIOverlap };
+    int aiOverlap { defaultAIOverlap };
+    AIFraming aiFraming;
+    AIFraming getAIFramingFor(LatencyMode mode, bool stateful) const;
+    void updateWarmupSizes();
+
+    // Everything that decides the chain's delays. Read from the parameters each block; a change is
+    // applied on the audio thread at once (no allocation) and reported to the host by timerCallback.
+    struct LatencyConfig
+    {
+        LatencyMode mode = LatencyMode::highQuality;
+        bool aiActive = false;
+        AIModelInterface::ModelType model = AIModelInterface::NOISE_REDUCTION;
+        bool stateful = false;      // the running model keeps state between frames
+        int modelInputSize = 0;     // the running model's fixed frame length, 0 if it takes any
+
+        bool operator!= (const LatencyConfig& other) const
+        {
+            return mode != other.mode || aiActive != other.aiActive || model != other.model || stateful != other.stateful
+                   || modelInputSize != other.modelInputSize;
+        }
+    };
+    LatencyConfig activeConfig;
+    int shifterLatency { 0 };   // pitch shifter, with compensation on
+    int gateLatency { 0 };      // gate lookahead
+    int activeLatency { 0 };
+    int hostBlockSize { 0 };    // largest block the host announced at prepareToPlay; the AI latency follows it
+    std::atomic<int> reportedLatency { 0 };
+    LatencyConfig getRequestedConfig() const;
+    int getLatencyFor(const LatencyConfig& config) const;
+
+    // Low Latency leaves the shifter uncompensated while AI runs, so that the AI framing alone
+    // sets the latency instead of the shifter's ~17 ms window. The DSP wet then lags the dry
+    // signal by that window, so spans the AI stream cannot fill (priming, late frames) take the
+    // dry signal instead, and the AI stream fades back in over aiFadeInLength samples.
+    static constexpr int aiFadeInLength = 64;
+    static bool isShifterCompensated(const LatencyConfig& config)
+    {
+        return config.mode == LatencyMode::highQuality || (config.mode == LatencyMode::lowLatency && ! config.aiActive);
+    }
+    int getDspLatencyFor(const LatencyConfig& config) const;
+    void applyLatencyConfig(const LatencyConfig& config);
+    void timerCallback() override;
+
+    // Delays the DSP chain's input so its output (and the dry signal) lands on the AI latency
+    CompensationDelay dspInputDelay;
+
+    // Inference runs on a worker thread; each frame has a callback period to come back.
+    // Samples we had to fill from the DSP chain are skipped when their frame finally arrives.
+    InferenceWorker inferenceWorker { aiInterface };
+    juce::uint32 aiGeneration { 0 };
+    bool aiWasEnabled { false };
+    bool aiResyncPending { false };
+    std::atomic<int> aiMissedFrames { 0 };
     AIModelInterface::ModelType aiDefaultModel { AIModelInterface::NOISE_REDUCTION };
 
-    // Simple formant filters per channel (F1,F2,F3)
-    juce::dsp::IIR::Filter<float> formantFilters[2][3];
+    // Stateful models restart their state when the transport jumps or starts playing
+    bool transportWasPlaying { false };
+    juce::int64 expectedTransportSample { -1 };
+    void checkTransportDiscontinuity(int numSamples);
+
+    // Formant peaks (F1,F2,F3), all channels filtered together in SIMD lanes
+    FormantFilterBank formantBank;
+
+    // Lookahead gate on the wet signal; delays the dry signal alongside it
+    NoiseGate noiseGate;
+
+    // Pitch, formant and gate run per formant lane group; wide layouts spread groups over the pool
+    ChannelTaskPool channelPool;
+    static constexpr int minParallelBlockSize = 64;
+    struct ChannelGroupTask
+    {
+        const float* const* input = nullptr;
+        float** delayedInput = nullptr;
+        float** processed = nullptr;
+        float** dry = nullptr;
+        float** gateGain = nullptr;
+        bool* gateActive = nullptr;
+        int numChannels = 0;
+        int numSamples = 0;
+        float pitchRatio = 1.0f;
+        std::array<juce::int64, 3> stageTicks[maxChannels] {};  // pitch, formant, gate per group
+    } groupTask;
+    void processChannelGroup(int group);
+
+    // Offline bounce (host non-realtime; set at prepareToPlay, and processBlock follows a host that
+    // switches without preparing again): instead of racing the worker, every AI frame completed in
+    // a block runs in one synchronous batch on the channel pool, so there is no DSP fallback.
+    // Frames are cut every hop and overlap-added as on the realtime path, but each is sent
+    // unwindowed with offlineContext samples of history and of lookahead around it; only the
+    // centre of the output is kept, and it takes both windows on the way out. The latency is the
+    // same as on the realtime path, which leaves room for the lookahead. A stateful model carries
+    // its context in its state and gets none, and so does a model with a fixed frame length the
+    // padded frame would not match; a stateful model's frames run in order per channel on one
+    // thread.
+    bool offlineMode { false };
+    bool offlineStateful { false };
+    int offlineContext { 0 };
+    int offlineThreadCount { 0 };
+    static int getOfflineContextFor(const AIFraming& framing, const LatencyConfig& config)
+    {
+        const int context = framing.frameSize / 2;
+        if (config.stateful || (config.modelInputSize > 0 && config.modelInputSize != framing.frameSize + 2 * context))
+            return 0;
+        return context;
+    }
+    struct OfflineFrame
+    {
+        int channel = 0;
+        bool success = false;
+        std::vector<float> window;      // input frame with its context either side
+        std::vector<float> processed;   // model output for it
+    };
+    std::vector<OfflineFrame> offlineFrames;
+    int numOfflineFrames { 0 };
+    AIModelInterface::ModelType offlineModel { AIModelInterface::NOISE_REDUCTION };
+    AIModelInterface::FrameParameters offlineParams;
+    void queueOfflineFrames(int channel, const float* input, int numSamples);
+    void runOfflineBatch();
+    void processOfflineFrame(int index);
+    void processOfflineChannel(int channel);
+    void switchOfflineMode(bool shouldBeOffline);
+
+    // Where processBlock's time goes, per stage
+    StageTelemetry telemetry;
+
+    // Moves both the real-time sanitizer and the telemetry on to the next stage (audio thread only)
+    void enterStage(ProcessingStage stage)
+    {
+        TITANVOCAL_RT_STAGE(stage);
+        telemetry.mark(stage);
+    }
 
-    void updateFormantFilters(float semitoneShift);
-    AIModelInterface::ModelType getSelectedModelType() const;
+    void resetAIStreams();
+    void collectAIResults();
+    void writeAIFrame(ChannelState& state, const float* frame);    // overlap-adds into the output ring
+    static AIModelInterface::ModelType getModelTypeForChoice(int choice);
+    AIModelInterface::ModelType getSelectedModelType() const;   // audio thread, this block's value
+    AIModelInterface::ModelType getCurrentModelType() const;    // any thread, live value
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TitanVocalProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,481 @@
+// TitanVocal - Proprietary Benchmark Suite
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: BenchMain.cpp
+// Description: Times processBlock, spectral analysis, spectrogram rendering and AI inference; emits JSON.
+#include <JuceHeader.h>
+#include "../Plugin/PluginProcessor.h"
+#include "../GUI/SpectralDisplay.h"
+#include "../DSP/FastMath.h"
+#include "VocalSignal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    bool quick = false;
+    bool printTable = true;
+
+    double microsecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+
+    // Per-call timings in microseconds, summarised as min / median / p99 / mean
+    juce::var summarise(std::vector<double> times)
+    {
+        std::sort(times.begin(), times.end());
+        double sum = 0.0;
+        for (auto t : times)
+            sum += t;
+
+        auto* stats = new juce::DynamicObject();
+        stats->setProperty("calls", (int) times.size());
+        stats->setProperty("minUs", times.front());
+        stats->setProperty("medianUs", times[times.size() / 2]);
+        stats->setProperty("p99Us", times[juce::jmin(times.size() - 1, times.size() * 99 / 100)]);
+        stats->setProperty("meanUs", sum / (double) times.size());
+        return juce::var(stats);
+    }
+
+    //==============================================================================
+    struct Settings
+    {
+        const char* name;
+        float dryWet, pitchAmount, formantShift, noiseAmount, saturation;
+        bool aiEnabled;
+    };
+
+    // light: every stage at its cheapest; default: Resources/Presets/Default.xml; heavy: every
+    // stage doing work; ai: default plus the AI exchange (through the built-in identity model)
+    const Settings settingsList[] = {
+        { "light",   1.0f, 0.5f,  0.0f, 0.0f, 0.0f, false },
+        { "default", 0.8f, 0.5f,  0.0f, 0.2f, 0.1f, false },
+        { "heavy",   1.0f, 0.75f, 3.0f, 0.6f, 0.5f, false },
+        { "ai",      0.8f, 0.5f,  0.0f, 0.2f, 0.1f, true  },
+    };
+
+    struct BlockCase
+    {
+        double sampleRate;
+        int blockSize;
+        int numChannels;
+        const Settings* settings;
+    };
+
+    void setParameter(TitanVocalProcessor& processor, const juce::String& id, float plainValue)
+    {
+        if (auto* param = processor.apvts.getParameter(id))
+            param->setValueNotifyingHost(param->convertTo0to1(plainValue));
+    }
+
+    juce::var benchProcessBlock(const BlockCase& c)
+    {
+        TitanVocalProcessor processor;
+        if (c.settings->aiEnabled)
+            processor.useIdentityModels();
+        auto layout = c.numChannels == 1 ? juce::AudioChannelSet::mono()
+                    : c.numChannels == 2 ? juce::AudioChannelSet::stereo()
+                                         : juce::AudioChannelSet::discreteChannels(c.numChannels);
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(layout);
+        buses.outputBuses.add(layout);
+        processor.setBusesLayout(buses);
+
+        const auto& s = *c.settings;
+        setParameter(processor, "dryWet", s.dryWet);
+        setParameter(processor, "pitchAmount", s.pitchAmount);
+        setParameter(processor, "formantShift", s.formantShift);
+        setParameter(processor, "noiseAmount", s.noiseAmount);
+        setParameter(processor, "saturation", s.saturation);
+        setParameter(processor, "aiEnabled", s.aiEnabled ? 1.0f : 0.0f);
+        processor.setRateAndBufferSizeDetails(c.sampleRate, c.blockSize);
+        processor.prepareToPlay(c.sampleRate, c.blockSize);
+
+        // Two seconds of audio (a quarter in quick mode), at least 64 blocks, after a 10% warm-up
+        const double seconds = quick ? 0.25 : 2.0;
+        const int numBlocks = juce::jmax(64, (int) (seconds * c.sampleRate / c.blockSize));
+        juce::AudioBuffer<float> buffer (c.numChannels, c.blockSize);
+        juce::MidiBuffer midi;
+        VocalSignal signal (c.sampleRate);
+
+        std::vector<double> times;
+        times.reserve((size_t) numBlocks);
+        for (int block = -numBlocks / 10; block < numBlocks; ++block)
+        {
+            signal.fill(buffer);
+            const auto start = Clock::now();
+            processor.processBlock(buffer, midi);
+            if (block >= 0)
+                times.push_back(microsecondsSince(start));
+        }
+        processor.releaseResources();
+
+        auto result = summarise(times);
+        auto* obj = result.getDynamicObject();
+        obj->setProperty("benchmark", "processBlock");
+        obj->setProperty("sampleRate", c.sampleRate);
+        obj->setProperty("blockSize", c.blockSize);
+        obj->setProperty("channels", c.numChannels);
+        obj->setProperty("settings", s.name);
+
+        // Realtime multiple at the median: block duration over processing time
+        const double blockUs = 1.0e6 * c.blockSize / c.sampleRate;
+        const double medianUs = (double) obj->getProperty("medianUs");
+        obj->setProperty("nsPerSampleChannel", 1000.0 * medianUs / ((double) c.blockSize * c.numChannels));
+        obj->setProperty("realtimeMultiple", blockUs / juce::jmax(1.0e-3, medianUs));
+
+        if (printTable)
+            std::printf("processBlock  %7.0f Hz  block %5d  ch %2d  %-8s median %9.2f us  p99 %9.2f us  %8.1fx realtime\n",
+                        c.sampleRate, c.blockSize, c.numChannels, s.name, medianUs,
+                        (double) obj->getProperty("p99Us"), (double) obj->getProperty("realtimeMultiple"));
+        return result;
+    }
+
+    std::vector<BlockCase> blockCases(bool full)
+    {
+        const double sampleRates[] = { 44100.0, 48000.0, 96000.0, 192000.0 };
+        const int blockSizes[] = { 16, 64, 256, 1024, 4096 };
+        const int channelCounts[] = { 1, 2, 6 };
+        const auto* defaults = &settingsList[1];
+
+        std::vector<BlockCase> cases;
+        if (full)
+        {
+            for (auto rate : sampleRates)
+                for (auto size : blockSizes)
+                    for (auto channels : channelCounts)
+                        for (const auto& settings : settingsList)
+                            cases.push_back({ rate, size, channels, &settings });
+            return cases;
+        }
+
+        // One axis at a time around 48 kHz / 512 / stereo / default
+        for (auto size : blockSizes)
+            cases.push_back({ 48000.0, size, 2, defaults });
+        for (auto rate : sampleRates)
+            cases.push_back({ rate, 512, 2, defaults });
+        for (auto channels : channelCounts)
+            cases.push_back({ 48000.0, 512, channels, defaults });
+        for (const auto& settings : settingsList)
+            cases.push_back({ 48000.0, 512, 2, &settings });
+        return cases;
+    }
+
+    //==============================================================================
+    template <typename Fn>
+    juce::var timeCalls(const char* name, int numCalls, Fn&& fn)
+    {
+        std::vector<double> times;
+        times.reserve((size_t) numCalls);
+        for (int i = -numCalls / 10; i < numCalls; ++i)
+        {
+            const auto start = Clock::now();
+            fn();
+            if (i >= 0)
+                times.push_back(microsecondsSince(start));
+        }
+
+        auto result = summarise(times);
+        result.getDynamicObject()->setProperty("benchmark", name);
+        if (printTable)
+            std::printf("%-34s median %9.2f us  p99 %9.2f us\n", name,
+                        (double) result["medianUs"], (double) result["p99Us"]);
+        return result;
+    }
+
+    void benchAnalysis(juce::Array<juce::var>& results)
+    {
+        constexpr double sampleRate = 48000.0;
+        const int numCalls = quick ? 200 : 2000;
+
+        juce::AudioBuffer<float> buffer (1, 512);
+        VocalSignal signal (sampleRate);
+        SpectralAnalyzer analyzer;
+
+        results.add(timeCalls("SpectralAnalyzer::computeSpectrum", numCalls, [&]
+        {
+            signal.fill(buffer);
+            analyzer.pushAudioBuffer(buffer.getReadPointer(0), buffer.getNumSamples());
+            analyzer.computeSpectrum();
+        }));
+
+        volatile float sink = 0.0f;
+        results.add(timeCalls("SpectralAnalyzer::estimatePitch", numCalls, [&] { sink = analyzer.estimatePitch((float) sampleRate); }));
+        juce::ignoreUnused(sink);
+
+        // The display only reads the analyzer and apvts, so a bare processor supplies both
+        TitanVocalProcessor processor;
+        SpectralDisplay display (analyzer, processor.apvts);
+        display.setSize(800, 400);
+
+        results.add(timeCalls("SpectralDisplay::updateSpectrogram", numCalls, [&] { display.updateSpectrogram(); }));
+
+        // Full paint into an offscreen image, as a repaint at 30 Hz would do
+        juce::Image target (juce::Image::ARGB, display.getWidth(), display.getHeight(), true);
+        results.add(timeCalls("SpectralDisplay::paint (800x400)", quick ? 20 : 200, [&]
+        {
+            juce::Graphics g (target);
+            display.paintEntireComponent(g, true);
+        }));
+    }
+
+    bool isPrecisionVariant(const juce::File& model)
+    {
+        const auto name = model.getFileNameWithoutExtension();
+        return name.endsWith(".fp16") || name.endsWith(".int8");
+    }
+
+    //==============================================================================
+    // Every *.onnx / *.pt in modelsDir, at a few frame sizes. Small local test models keep this
+    // quick; skipped (and reported as such) when there are none or no backend is compiled in.
+    void benchInference(juce::Array<juce::var>& results, const juce::File& modelsDir)
+    {
+        const auto models = modelsDir.findChildFiles(juce::File::findFiles, false, "*.onnx;*.pt");
+        if (models.isEmpty())
+        {
+            if (printTable)
+                std::printf("AIModelInterface::processFrame    skipped: no models in %s\n", modelsDir.getFullPathName().toRawUTF8());
+            return;
+        }
+
+        AIModelInterface::FrameParameters params;
+        params.pitchAmount = 0.5f;
+        params.noiseAmount = 0.2f;
+        params.saturation = 0.1f;
+        VocalSignal signal (48000.0);
+
+        for (const auto& model : models)
+        {
+            if (isPrecisionVariant(model))
+                continue;
+
+            AIModelInterface ai;
+            if (! ai.loadModel(AIModelInterface::NOISE_REDUCTION, model.getFullPathName().toStdString()))
+            {
+                std::fprintf(stderr, "Cannot load %s\n", model.getFullPathName().toRawUTF8());
+                continue;
+            }
+
+            // Bring-up cost, as loadModel profiled it
+            const auto config = ai.getModelConfig(AIModelInterface::NOISE_REDUCTION);
+            auto* load = new juce::DynamicObject();
+            load->setProperty("benchmark", "AIModelInterface::loadModel");
+            load->setProperty("model", model.getFileName());
+            load->setProperty("loadMs", config.loadMs);
+            load->setProperty("optimizeMs", config.optimizeMs);
+            load->setProperty("warmupMs", config.warmupMs);
+            load->setProperty("warmupRuns", config.warmupRuns);
+            load->setProperty("firstInferenceMs", config.firstInferenceMs);
+            load->setProperty("steadyInferenceMs", config.steadyInferenceMs);
+            results.add(juce::var(load));
+            if (printTable)
+                std::printf("%-34s %s: load %.1f ms, optimize %.1f ms, warm-up %.1f ms, first %.2f ms, steady %.2f ms\n",
+                            "AIModelInterface::loadModel", model.getFileName().toRawUTF8(), config.loadMs, config.optimizeMs, config.warmupMs,
+                            config.firstInferenceMs, config.steadyInferenceMs);
+
+            for (int frameSize : { 256, 1024, 2048 })
+            {
+                juce::AudioBuffer<float> buffer (1, frameSize);
+                signal.fill(buffer);
+                std::vector<float> output ((size_t) frameSize);
+
+                // The streaming overload the inference worker uses; the first call builds the
+                // binding for this frame length, later ones reuse it
+                bool ok = true;
+                auto result = timeCalls("AIModelInterface::processFrame", quick ? 10 : 100, [&]
+                {
+                    ok &= ai.processFrame(AIModelInterface::NOISE_REDUCTION, buffer.getReadPointer(0), frameSize, params, output.data());
+                });
+
+                auto* obj = result.getDynamicObject();
+                obj->setProperty("model", model.getFileName());
+                obj->setProperty("frameSize", frameSize);
+                obj->setProperty("success", ok);
+                obj->setProperty("realtimeMultiple", 1.0e6 * frameSize / 48000.0 / juce::jmax(1.0e-3, (double) result["medianUs"]));
+                results.add(result);
+            }
+        }
+    }
+
+    // Magnitude-spectrum difference energy relative to the reference's, in dB, over Hann frames
+    double spectralErrorDb(const std::vector<float>& reference, const std::vector<float>& test, int frameSize)
+    {
+        juce::dsp::FFT fft (juce::roundToInt(std::log2((double) frameSize)));
+        juce::dsp::WindowingFunction<float> window ((size_t) frameSize, juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> a ((size_t) (2 * frameSize)), b ((size_t) (2 * frameSize));
+        double errorEnergy = 0.0, referenceEnergy = 0.0;
+
+        for (size_t start = 0; start + (size_t) frameSize <= reference.size(); start += (size_t) frameSize)
+        {
+            std::fill(a.begin(), a.end(), 0.0f);
+            std::fill(b.begin(), b.end(), 0.0f);
+            std::copy(reference.begin() + (long) start, reference.begin() + (long) start + frameSize, a.begin());
+            std::copy(test.begin() + (long) start, test.begin() + (long) start + frameSize, b.begin());
+            window.multiplyWithWindowingTable(a.data(), (size_t) frameSize);
+            window.multiplyWithWindowingTable(b.data(), (size_t) frameSize);
+            fft.performFrequencyOnlyForwardTransform(a.data());
+            fft.performFrequencyOnlyForwardTransform(b.data());
+
+            for (int bin = 0; bin <= frameSize / 2; ++bin)
+            {
+                referenceEnergy += (double) a[(size_t) bin] * a[(size_t) bin];
+                errorEnergy += (double) (a[(size_t) bin] - b[(size_t) bin]) * (a[(size_t) bin] - b[(size_t) bin]);
+            }
+        }
+        return 10.0 * std::log10(juce::jmax(errorEnergy, 1.0e-30) / juce::jmax(referenceEnergy, 1.0e-30));
+    }
+
+    // FP16 and INT8 sidecars of every model in modelsDir against the FP32 file, at the realtime
+    // frame size: latency, speed-up and how far the output spectrum moves. ModelType slots all load
+    // the same default files in the plugin, so results are per model file.
+    void benchPrecision(juce::Array<juce::var>& results, const juce::File& modelsDir)
+    {
+        constexpr int frameSize = 1024;
+        constexpr int numFrames = 8;
+        const char* names[] = { "AI precision fp32", "AI precision fp16", "AI precision int8" };
+
+        AIModelInterface::FrameParameters params;
+        params.pitchAmount = 0.5f;
+        params.noiseAmount = 0.2f;
+        params.saturation = 0.1f;
+
+        VocalSignal signal (48000.0);
+        juce::AudioBuffer<float> input (1, frameSize * numFrames);
+        signal.fill(input);
+
+        for (const auto& model : modelsDir.findChildFiles(juce::File::findFiles, false, "*.onnx;*.pt"))
+        {
+            if (isPrecisionVariant(model))
+                continue;
+
+            const auto path = model.getFullPathName().toStdString();
+            std::vector<float> reference;
+            double referenceUs = 0.0;
+
+            for (int precision : { (int) AIModelInterface::FP32, (int) AIModelInterface::FP16, (int) AIModelInterface::INT8 })
+            {
+                if (precision != AIModelInterface::FP32 && AIModelInterface::getPrecisionVariantPath(path, precision) == path)
+                {
+                    if (printTable)
+                        std::printf("%-34s skipped: no sidecar for %s\n", names[precision], model.getFileName().toRawUTF8());
+                    continue;
+                }
+
+                AIModelInterface ai;
+                ai.setPrecision(precision);
+                if (! ai.loadModel(AIModelInterface::NOISE_REDUCTION, path))
+                {
+                    std::fprintf(stderr, "Cannot load %s at %s\n", path.c_str(), names[precision]);
+                    continue;
+                }
+
+                // Whole signal once for the error, then the first frame repeatedly for timing
+                std::vector<float> output ((size_t) (frameSize * numFrames));
+                bool ok = true;
+                for (int f = 0; f < numFrames; ++f)
+                    ok &= ai.processFrame(AIModelInterface::NOISE_REDUCTION, input.getReadPointer(0, f * frameSize), frameSize,
+                                          params, output.data() + f * frameSize);
+
+                auto result = timeCalls(names[precision], quick ? 10 : 100, [&]
+                {
+                    ok &= ai.processFrame(AIModelInterface::NOISE_REDUCTION, input.getReadPointer(0), frameSize, params, output.data());
+                });
+
+                auto* obj = result.getDynamicObject();
+                obj->setProperty("model", model.getFileName());
+                obj->setProperty("loadedFile", juce::File(ai.getModelConfig(AIModelInterface::NOISE_REDUCTION).modelPath).getFileName());
+                obj->setProperty("frameSize", frameSize);
+                obj->setProperty("success", ok);
+
+                if (precision == AIModelInterface::FP32)
+                {
+                    reference = output;
+                    referenceUs = result["medianUs"];
+                }
+                else if (! reference.empty())
+                {
+                    const double speedup = referenceUs / juce::jmax(1.0e-3, (double) result["medianUs"]);
+                    const double errorDb = spectralErrorDb(reference, output, frameSize);
+                    obj->setProperty("speedupVsFp32", speedup);
+                    obj->setProperty("spectralErrorDb", errorDb);
+                    if (printTable)
+                        std::printf("%-34s %.2fx faster than fp32, spectral error %.1f dB\n", "", speedup, errorDb);
+                }
+                results.add(result);
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("Usage: TitanVocal_Bench [--quick] [--full] [--json=FILE|-] [--models=DIR] [--only=processBlock|analysis|ai|precision]\n"
+                    "  --quick   shorter runs (noisier numbers)\n"
+                    "  --full    processBlock over every rate x block x channels x settings combination\n"
+                    "  --json    write results as JSON (\"-\" for stdout, which silences the table)\n"
+                    "  --models  directory of small *.onnx / *.pt test models for processFrame (default: Resources/Models)\n");
+        return 0;
+    }
+
+    quick = args.containsOption("--quick");
+    const bool full = args.containsOption("--full");
+    const auto jsonPath = args.getValueForOption("--json");
+    const auto only = args.getValueForOption("--only");
+    printTable = jsonPath != "-";
+
+    auto modelsDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile).getParentDirectory()
+                         .getChildFile("Resources").getChildFile("Models");
+    if (args.containsOption("--models"))
+        modelsDir = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--models"));
+
+    juce::Array<juce::var> results;
+    if (only.isEmpty() || only == "processBlock")
+        for (const auto& c : blockCases(full))
+            results.add(benchProcessBlock(c));
+    if (only.isEmpty() || only == "analysis")
+        benchAnalysis(results);
+    if (only.isEmpty() || only == "ai")
+        benchInference(results, modelsDir);
+    if (only.isEmpty() || only == "precision")
+        benchPrecision(results, modelsDir);
+
+    // Enough about the machine and build to tell whether two result files are comparable
+    auto* system = new juce::DynamicObject();
+    system->setProperty("cpu", juce::SystemStats::getCpuModel());
+    system->setProperty("cores", juce::SystemStats::getNumCpus());
+    system->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    system->setProperty("instructionSet", FastMath::getInstructionSetName());
+   #if JUCE_DEBUG
+    system->setProperty("buildType", "Debug");
+   #else
+    system->setProperty("buildType", "Release");
+   #endif
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("schema", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("quick", quick);
+    root->setProperty("system", juce::var(system));
+    root->setProperty("results", results);
+    const auto json = juce::JSON::toString(juce::var(root));
+
+    if (jsonPath == "-")
+        std::printf("%s\n", json.toRawUTF8());
+    else if (jsonPath.isNotEmpty() && ! juce::File::getCurrentWorkingDirectory().getChildFile(jsonPath).replaceWithText(json))
+    {
+        std::fprintf(stderr, "Cannot write %s\n", jsonPath.toRawUTF8());
+        return 1;
+    }
+    return 0;
+}
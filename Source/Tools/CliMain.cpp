@@ -0,0 +1,311 @@
+// TitanVocal - Proprietary Batch Renderer
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: CliMain.cpp
+// Description: Headless command-line renderer that runs audio files through the full processing chain.
+#include <JuceHeader.h>
+#include "../Plugin/PluginProcessor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    void printUsage()
+    {
+        std::printf("Usage: TitanVocal_Cli --output=DIR [options] <file or directory>...\n"
+                    "  -o, --output=DIR    where rendered files are written (created if missing)\n"
+                    "  -p, --preset=FILE   preset XML (Resources/Presets format or a saved state)\n"
+                    "  -j, --jobs=N        files rendered at once (default: one per core)\n"
+                    "  --block=N           processing block size (default 1024)\n"
+                    "  --format=EXT        output format: wav, aiff or flac (default: same as input)\n"
+                    "  --precision=P       AI model precision: fp32, fp16 or int8 (uses the model's sidecar file)\n"
+                    "  --ai-overlap=N      AI frames overlapping each sample: 1, 2, 4 or 8 (default 4)\n"
+                    "  -r, --recursive     search directories recursively\n"
+                    "Reads WAV, AIFF and FLAC. Output is latency-compensated and the same length as the input.\n");
+    }
+
+    struct Input
+    {
+        juce::File file;
+        juce::File root;    // directory it was found in, so the relative layout is kept
+    };
+
+    juce::Array<Input> collectInputs(const juce::StringArray& paths, bool recursive)
+    {
+        constexpr auto wildcard = "*.wav;*.aif;*.aiff;*.flac";
+        juce::Array<Input> inputs;
+        for (const auto& path : paths)
+        {
+            const auto target = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+            if (target.isDirectory())
+            {
+                for (const auto& entry : juce::RangedDirectoryIterator(target, recursive, wildcard, juce::File::findFiles))
+                    inputs.add({ entry.getFile(), target });
+            }
+            else if (target.existsAsFile())
+            {
+                inputs.add({ target, target.getParentDirectory() });
+            }
+            else
+            {
+                std::fprintf(stderr, "Skipping %s: not found\n", path.toRawUTF8());
+            }
+        }
+        return inputs;
+    }
+
+    struct RenderResult
+    {
+        juce::String error;     // empty on success
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;
+    };
+
+    // One per worker thread: owns a processor, so no state is shared between files in flight
+    class Renderer
+    {
+    public:
+        Renderer(const juce::XmlElement* presetXml, int blockSizeToUse, int offlineThreads, int precision, int aiOverlap)
+            : preset(presetXml), blockSize(blockSizeToUse)
+        {
+            formats.registerBasicFormats();
+            processor.setOfflineThreadCount(offlineThreads);
+            // Frames already run one per pool thread, and the renderers share the cores between
+            // them; more threads per inference would only oversubscribe the CPU
+            processor.setModelThreadCount(1);
+            processor.setModelPrecision(precision);
+            processor.setAIOverlap(aiOverlap);
+        }
+
+        RenderResult render(const juce::File& input, const juce::File& output)
+        {
+            RenderResult result;
+            const auto start = std::chrono::steady_clock::now();
+
+            std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor(input));
+            if (reader == nullptr)
+                return fail(result, "unreadable or unsupported format");
+
+            const int numChannels = (int) reader->numChannels;
+            const double sampleRate = reader->sampleRate;
+            const auto length = reader->lengthInSamples;
+
+            auto layout = numChannels == 1 ? juce::AudioChannelSet::mono()
+                        : numChannels == 2 ? juce::AudioChannelSet::stereo()
+                                           : juce::AudioChannelSet::discreteChannels(numChannels);
+            juce::AudioProcessor::BusesLayout buses;
+            buses.inputBuses.add(layout);
+            buses.outputBuses.add(layout);
+            if (! processor.setBusesLayout(buses))
+                return fail(result, "unsupported channel count " + juce::String(numChannels));
+
+            auto* format = formats.findFormatForFileExtension(output.getFileExtension());
+            if (format == nullptr)
+                return fail(result, "no writer for " + output.getFileExtension());
+
+            // Keep the source bit depth where the output format allows it, else its deepest
+            const auto depths = format->getPossibleBitDepths();
+            const int bitDepth = depths.contains((int) reader->bitsPerSample) ? (int) reader->bitsPerSample
+                                                                               : depths.getLast();
+
+            output.getParentDirectory().createDirectory();
+            output.deleteFile();
+            auto stream = std::make_unique<juce::FileOutputStream>(output);
+            if (! stream->openedOk())
+                return fail(result, "cannot write " + output.getFullPathName());
+
+            std::unique_ptr<juce::AudioFormatWriter> writer (format->createWriterFor(stream.get(), sampleRate, (unsigned int) numChannels,
+                                                                                     bitDepth, reader->metadataValues, 0));
+            if (writer == nullptr)
+                return fail(result, "format rejected " + juce::String(numChannels) + " channels at " + juce::String(sampleRate) + " Hz");
+            stream.release();
+
+            // Fresh state per file; presets go in before prepare so smoothing starts settled
+            if (preset != nullptr)
+                processor.applyPreset(*preset);
+            processor.setNonRealtime(true);
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            // Run the latency's worth of silence past the end and drop it from the front, so the
+            // output lines up with the input sample for sample
+            const juce::int64 latency = processor.getLatencySamples();
+            const juce::int64 total = length + latency;
+            juce::AudioBuffer<float> buffer (numChannels, blockSize);
+            juce::MidiBuffer midi;
+
+            for (juce::int64 position = 0; position < total; position += blockSize)
+            {
+                const int numSamples = (int) juce::jmin((juce::int64) blockSize, total - position);
+                buffer.setSize(numChannels, numSamples, false, false, true);
+                buffer.clear();
+                if (position < length)
+                    reader->read(&buffer, 0, (int) juce::jmin((juce::int64) numSamples, length - position), position, true, true);
+
+                processor.processBlock(buffer, midi);
+
+                const int skip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+                if (skip < numSamples && ! writer->writeFromAudioSampleBuffer(buffer, skip, numSamples - skip))
+                {
+                    processor.releaseResources();
+                    return fail(result, "write failed");
+                }
+            }
+            processor.releaseResources();
+
+            result.audioSeconds = (double) length / sampleRate;
+            result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return result;
+        }
+
+    private:
+        TitanVocalProcessor processor;
+        juce::AudioFormatManager formats;
+        const juce::XmlElement* preset;
+        int blockSize;
+
+        static RenderResult fail(RenderResult& result, const juce::String& message)
+        {
+            result.error = message;
+            return result;
+        }
+    };
+
+    juce::File outputFileFor(const Input& input, const juce::File& outputDir, const juce::String& format)
+    {
+        auto target = outputDir.getChildFile(input.file.getRelativePathFrom(input.root));
+        return format.isEmpty() ? target : target.withFileExtension(format);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args (argc, argv);
+
+    if (args.size() == 0 || args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+
+    const auto outputPath = args.removeValueForOption("--output|-o");
+    const auto presetPath = args.removeValueForOption("--preset|-p");
+    const auto jobsText = args.removeValueForOption("--jobs|-j");
+    const auto blockText = args.removeValueForOption("--block");
+    const auto format = args.removeValueForOption("--format").trimCharactersAtStart(".").toLowerCase();
+    const bool recursive = args.removeOptionIfFound("--recursive|-r");
+    const auto precisionText = args.removeValueForOption("--precision").toLowerCase();
+    const auto overlapText = args.removeValueForOption("--ai-overlap");
+
+    if (outputPath.isEmpty())
+    {
+        std::fprintf(stderr, "Missing --output=DIR\n");
+        printUsage();
+        return 1;
+    }
+    if (format.isNotEmpty() && ! juce::StringArray { "wav", "aiff", "aif", "flac" }.contains(format))
+    {
+        std::fprintf(stderr, "Unknown --format=%s\n", format.toRawUTF8());
+        return 1;
+    }
+
+    const int precision = juce::StringArray { "fp32", "fp16", "int8" }.indexOf(precisionText.isEmpty() ? "fp32" : precisionText);
+    if (precision < 0)
+    {
+        std::fprintf(stderr, "Unknown --precision=%s\n", precisionText.toRawUTF8());
+        return 1;
+    }
+
+    const int aiOverlap = overlapText.isNotEmpty() ? overlapText.getIntValue() : TitanVocalProcessor::defaultAIOverlap;
+    if (aiOverlap != 1 && aiOverlap != 2 && aiOverlap != 4 && aiOverlap != 8)
+    {
+        std::fprintf(stderr, "Unknown --ai-overlap=%s (use 1, 2, 4 or 8)\n", overlapText.toRawUTF8());
+        return 1;
+    }
+
+    std::unique_ptr<juce::XmlElement> preset;
+    if (presetPath.isNotEmpty())
+    {
+        preset = juce::XmlDocument::parse(juce::File::getCurrentWorkingDirectory().getChildFile(presetPath));
+        if (preset == nullptr)
+        {
+            std::fprintf(stderr, "Cannot parse preset %s\n", presetPath.toRawUTF8());
+            return 1;
+        }
+    }
+
+    juce::StringArray paths;
+    for (const auto& arg : args.arguments)
+        if (! arg.isOption())
+            paths.add(arg.text);
+
+    const auto inputs = collectInputs(paths, recursive);
+    if (inputs.isEmpty())
+    {
+        std::fprintf(stderr, "No input files\n");
+        return 1;
+    }
+
+    const auto outputDir = juce::File::getCurrentWorkingDirectory().getChildFile(outputPath);
+    const int blockSize = blockText.isNotEmpty() ? juce::jlimit(16, 65536, blockText.getIntValue()) : 1024;
+    const int numCpus = juce::SystemStats::getNumCpus();
+    const int numJobs = juce::jlimit(1, inputs.size(), jobsText.isNotEmpty() ? jobsText.getIntValue() : numCpus);
+
+    // Parallelism goes to files first; any cores left over go to each processor's offline pool
+    const int threadsPerRenderer = juce::jmax(1, numCpus / numJobs);
+
+    // Processors are created here on the message thread, then each worker uses only its own
+    std::vector<std::unique_ptr<Renderer>> renderers;
+    for (int i = 0; i < numJobs; ++i)
+        renderers.push_back(std::make_unique<Renderer>(preset.get(), blockSize, threadsPerRenderer, precision, aiOverlap));
+
+    std::printf("Rendering %d file(s) with %d job(s), block %d\n", inputs.size(), numJobs, blockSize);
+
+    std::atomic<int> nextInput { 0 };
+    std::atomic<int> numFailed { 0 };
+    std::mutex printLock;
+    double totalAudioSeconds = 0.0;
+    const auto batchStart = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (auto& renderer : renderers)
+    {
+        workers.emplace_back([&, r = renderer.get()]
+        {
+            for (int i = nextInput++; i < inputs.size(); i = nextInput++)
+            {
+                const auto& input = inputs.getReference(i);
+                const auto output = outputFileFor(input, outputDir, format);
+                const auto result = r->render(input.file, output);
+
+                std::lock_guard<std::mutex> lock (printLock);
+                if (result.error.isNotEmpty())
+                {
+                    ++numFailed;
+                    std::fprintf(stderr, "FAILED  %s: %s\n", input.file.getFullPathName().toRawUTF8(), result.error.toRawUTF8());
+                    continue;
+                }
+
+                totalAudioSeconds += result.audioSeconds;
+                std::printf("%8.2f s  %7.1fx  %s\n", result.audioSeconds,
+                            result.audioSeconds / juce::jmax(1.0e-9, result.wallSeconds),
+                            output.getFullPathName().toRawUTF8());
+            }
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchStart).count();
+    std::printf("%d rendered, %d failed: %.1f s of audio in %.1f s (%.1fx realtime)\n",
+                inputs.size() - numFailed.load(), numFailed.load(), totalAudioSeconds, wallSeconds,
+                totalAudioSeconds / juce::jmax(1.0e-9, wallSeconds));
+
+    return numFailed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// TitanVocal - Proprietary Fast Math Accuracy Check and Benchmark
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: FastMathCheckMain.cpp
+// Description: Bounds the error of every FastMath function against the standard library and times both.
+#include "../DSP/FastMath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    struct Range
+    {
+        const char* name;
+        float from, to;     // input range, swept densely
+        bool relative;      // relative or absolute error
+        double bound;
+    };
+
+    constexpr int numValues = 1 << 20;
+    int repeats = 20;
+    volatile float sink = 0.0f;
+
+    template <typename Fn>
+    double nanosecondsPerValue(Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+            fn();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / ((double) numValues * repeats);
+    }
+
+    // Sweeps the range, checks scalar and array forms against the double-precision reference, and
+    // times them against the library call the plugin used before. Returns true if within bound.
+    template <typename Reference, typename Scalar, typename Array, typename Library>
+    bool runCheck(const Range& range, Reference reference, Scalar scalar, Array array, Library library)
+    {
+        std::vector<float> input ((size_t) numValues), output ((size_t) numValues);
+        for (int i = 0; i < numValues; ++i)
+            input[(size_t) i] = range.from + (range.to - range.from) * (float) i / (float) (numValues - 1);
+
+        auto errorOf = [&](double expected, float actual)
+        {
+            const double diff = std::abs((double) actual - expected);
+            return range.relative ? diff / std::max(std::abs(expected), 1.0e-30) : diff;
+        };
+
+        array(input.data(), output.data(), numValues);
+        double worst = 0.0;
+        for (int i = 0; i < numValues; ++i)
+        {
+            const double expected = reference((double) input[(size_t) i]);
+            worst = std::max(worst, errorOf(expected, scalar(input[(size_t) i])));
+            worst = std::max(worst, errorOf(expected, output[(size_t) i]));
+        }
+
+        const double libraryNs = nanosecondsPerValue([&] {
+            for (int i = 0; i < numValues; ++i)
+                output[(size_t) i] = library(input[(size_t) i]);
+            sink = sink + output[0];
+        });
+        const double scalarNs = nanosecondsPerValue([&] {
+            for (int i = 0; i < numValues; ++i)
+                output[(size_t) i] = scalar(input[(size_t) i]);
+            sink = sink + output[0];
+        });
+        const double arrayNs = nanosecondsPerValue([&] {
+            array(input.data(), output.data(), numValues);
+            sink = sink + output[0];
+        });
+
+        const bool pass = worst <= range.bound;
+        std::printf("%-16s %12.3g %12.3g %10.2f %10.2f %10.2f %7.1fx %s\n", range.name, worst, range.bound,
+                    libraryNs, scalarNs, arrayNs, libraryNs / std::min(scalarNs, arrayNs), pass ? "" : "FAIL");
+        return pass;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--quick") == 0)
+        repeats = 2;
+
+    std::printf("FastMath vector unit: %s\n\n", FastMath::getInstructionSetName());
+    std::printf("%-16s %12s %12s %10s %10s %10s %8s\n", "function", "max error", "bound", "std ns", "scalar ns", "array ns", "speedup");
+
+    int failures = 0;
+    auto count = [&](bool pass) { failures += pass ? 0 : 1; };
+
+    count(runCheck({ "tanh", -12.0f, 12.0f, false, 2.0e-6 },
+                   [](double x) { return std::tanh(x); },
+                   [](float x) { return FastMath::tanh(x); },
+                   [](const float* in, float* out, int n) { FastMath::tanh(in, out, n); },
+                   [](float x) { return std::tanh(x); }));
+
+    count(runCheck({ "exp2", -100.0f, 100.0f, true, 5.0e-7 },
+                   [](double x) { return std::exp2(x); },
+                   [](float x) { return FastMath::exp2(x); },
+                   [](const float* in, float* out, int n) { FastMath::exp2(in, out, n); },
+                   [](float x) { return std::pow(2.0f, x); }));
+
+    count(runCheck({ "log2", 1.0e-6f, 1.0e6f, false, 2.0e-6 },
+                   [](double x) { return std::log2(x); },
+                   [](float x) { return FastMath::log2(x); },
+                   [](const float* in, float* out, int n) { FastMath::log2(in, out, n); },
+                   [](float x) { return std::log2(x); }));
+
+    count(runCheck({ "log1p", 0.0f, 1000.0f, false, 1.0e-6 },
+                   [](double x) { return std::log1p(x); },
+                   [](float x) { return FastMath::log1p(x); },
+                   [](const float* in, float* out, int n) { for (int i = 0; i < n; ++i) out[i] = FastMath::log1p(in[i]); },
+                   [](float x) { return std::log1p(x); }));
+
+    count(runCheck({ "decibelsToGain", -99.0f, 24.0f, true, 1.0e-6 },
+                   [](double dB) { return std::pow(10.0, dB / 20.0); },
+                   [](float dB) { return FastMath::decibelsToGain(dB); },
+                   [](const float* in, float* out, int n) { FastMath::decibelsToGain(in, out, n); },
+                   [](float dB) { return dB > -100.0f ? std::pow(10.0f, dB * 0.05f) : 0.0f; }));
+
+    count(runCheck({ "gainToDecibels", 1.0e-4f, 16.0f, false, 1.0e-5 },
+                   [](double g) { return 20.0 * std::log10(g); },
+                   [](float g) { return FastMath::gainToDecibels(g); },
+                   [](const float* in, float* out, int n) { FastMath::gainToDecibels(in, out, n); },
+                   [](float g) { return g > 0.0f ? std::max(-100.0f, 20.0f * std::log10(g)) : -100.0f; }));
+
+    std::printf("\n%s: %d function(s) outside their error bound\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,314 @@
+// TitanVocal - Proprietary Real-time Safety Check Driver
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// See LICENSE.txt for strict proprietary licensing terms.
+//
+// File: RealtimeCheckMain.cpp
+// Description: Headless driver that runs processBlock under the real-time sanitizer and fails on violations.
+#include <JuceHeader.h>
+#include "../Plugin/PluginProcessor.h"
+#include "../Core/RealtimeSanitizer.h"
+#include "VocalSignal.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    struct Scenario
+    {
+        const char* name;
+        int blockSize;
+        int numChannels;
+        bool aiEnabled;
+        float saturation;
+        float noiseAmount;
+        float formantShift;
+        int latencyMode;        // 0 zero, 1 low, 2 high quality; -1 cycles through all of them
+        bool statefulModel = false;
+    };
+
+    void setParameter(TitanVocalProcessor& processor, const juce::String& id, float plainValue)
+    {
+        if (auto* param = processor.apvts.getParameter(id))
+            param->setValueNotifyingHost(param->convertTo0to1(plainValue));
+    }
+
+    int runScenario(const Scenario& scenario)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numBlocks = 400;
+
+        // No model files ship with the checks; AI runs through the built-in identity model
+        TitanVocalProcessor processor;
+        if (scenario.aiEnabled)
+            processor.useIdentityModels(scenario.statefulModel);
+        auto layout = scenario.numChannels == 1 ? juce::AudioChannelSet::mono()
+                    : scenario.numChannels == 2 ? juce::AudioChannelSet::stereo()
+                                                : juce::AudioChannelSet::discreteChannels(scenario.numChannels);
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(layout);
+        buses.outputBuses.add(layout);
+        processor.setBusesLayout(buses);
+        processor.setRateAndBufferSizeDetails(sampleRate, scenario.blockSize);
+
+        setParameter(processor, "aiEnabled", scenario.aiEnabled ? 1.0f : 0.0f);
+        setParameter(processor, "saturation", scenario.saturation);
+        setParameter(processor, "noiseAmount", scenario.noiseAmount);
+        setParameter(processor, "formantShift", scenario.formantShift);
+        setParameter(processor, "latencyMode", (float) juce::jmax(0, scenario.latencyMode));
+        processor.prepareToPlay(sampleRate, scenario.blockSize);
+
+        juce::AudioBuffer<float> buffer (scenario.numChannels, scenario.blockSize);
+        juce::MidiBuffer midi;
+        VocalSignal signal (sampleRate);
+
+        RealtimeSanitizer::resetViolationCounts();
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            // Sweep the formant shift so change-driven code paths run too
+            if (block % 50 == 0)
+                setParameter(processor, "formantShift", scenario.formantShift + (float) (block / 50 % 3) - 1.0f);
+
+            // Mode changes re-time the whole chain on the audio thread
+            if (scenario.latencyMode < 0 && block % 40 == 20)
+                setParameter(processor, "latencyMode", (float) (block / 40 % 3));
+
+            signal.fill(buffer);
+            processor.processBlock(buffer, midi);
+        }
+
+        // Pool overruns depend on the machine's load and are reported, not failed on
+        const int violations = RealtimeSanitizer::getTotalViolationCount();
+        std::printf("%-28s block %5d  ch %d  violations %d  pool overruns %d\n", scenario.name, scenario.blockSize,
+                    scenario.numChannels, violations, processor.getChannelPoolOverruns());
+        for (int s = 0; s < numProcessingStages; ++s)
+            if (const int n = RealtimeSanitizer::getViolationCount((ProcessingStage) s))
+                std::printf("    %-14s %d\n", getProcessingStageName((ProcessingStage) s), n);
+
+        processor.releaseResources();
+        return violations;
+    }
+
+    // Stereo, AI on through the identity model, half dry and half wet, every other stage neutral
+    void prepareAIProcessor(TitanVocalProcessor& processor, double sampleRate, int blockSize, int latencyMode, bool statefulModel)
+    {
+        processor.useIdentityModels(statefulModel);
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(juce::AudioChannelSet::stereo());
+        buses.outputBuses.add(juce::AudioChannelSet::stereo());
+        processor.setBusesLayout(buses);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+        setParameter(processor, "aiEnabled", 1.0f);
+        setParameter(processor, "saturation", 0.0f);
+        setParameter(processor, "noiseAmount", 0.0f);
+        setParameter(processor, "formantShift", 0.0f);
+        setParameter(processor, "dryWet", 0.5f);
+        setParameter(processor, "latencyMode", (float) latencyMode);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    // Paced like a live host, with the identity model: inference costs next to nothing, so a
+    // missed frame is down to the latency budget or the worker's wake-up. Half dry, half AI, so
+    // a wet path that does not line up with the dry one comb-filters; the output has to be the
+    // input delayed by the reported latency. The worker is an ordinary thread and the wall clock
+    // decides, so a couple of misses (and the DSP fill they bring) are put down to scheduling;
+    // a budget that is wrong misses in every block, and a misaligned path fails every sample.
+    struct TimingScenario
+    {
+        const char* name;
+        int blockSize;
+        int latencyMode;        // 1 low, 2 high quality
+        bool statefulModel;
+    };
+
+    int runTimingScenario(const TimingScenario& scenario)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numChannels = 2;
+        constexpr double seconds = 1.5;
+        constexpr float tolerance = 1.0e-4f;
+        constexpr int maxMissedFrames = 2;
+        constexpr double maxMismatchedFraction = 0.05;
+
+        TitanVocalProcessor processor;
+        prepareAIProcessor(processor, sampleRate, scenario.blockSize, scenario.latencyMode, scenario.statefulModel);
+        const int latency = processor.getLatencySamples();
+
+        const int numBlocks = (int) std::ceil(seconds * sampleRate / scenario.blockSize);
+        std::vector<float> input;
+        std::vector<float> output[numChannels];
+        input.reserve((size_t) (numBlocks * scenario.blockSize));
+        for (auto& channel : output)
+            channel.reserve(input.capacity());
+
+        juce::AudioBuffer<float> buffer (numChannels, scenario.blockSize);
+        juce::MidiBuffer midi;
+        VocalSignal signal (sampleRate);
+
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(scenario.blockSize / sampleRate));
+        auto due = std::chrono::steady_clock::now();
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            signal.fill(buffer);
+            input.insert(input.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + scenario.blockSize);
+            processor.processBlock(buffer, midi);
+            for (int ch = 0; ch < numChannels; ++ch)
+                output[ch].insert(output[ch].end(), buffer.getReadPointer(ch), buffer.getReadPointer(ch) + scenario.blockSize);
+
+            due += period;
+            std::this_thread::sleep_until(due);
+        }
+        const int missed = processor.getAIMissedFrames();
+        processor.releaseResources();
+
+        // The first latency's worth of output is the DSP chain while the AI stream fills
+        size_t numCompared = 0, numMismatched = 0;
+        for (const auto& channel : output)
+        {
+            for (size_t i = (size_t) latency; i < channel.size(); ++i, ++numCompared)
+                if (std::abs(channel[i] - input[i - (size_t) latency]) > tolerance)
+                    ++numMismatched;
+        }
+
+        const bool aligned = missed == 0 ? numMismatched == 0
+                                         : (double) numMismatched <= maxMismatchedFraction * (double) numCompared;
+        const bool failed = latency <= 0 || missed > maxMissedFrames || ! aligned;
+        std::printf("%-28s block %5d  latency %5d  missed %d  mismatched %zu/%zu%s\n", scenario.name,
+                    scenario.blockSize, latency, missed, numMismatched, numCompared, failed ? "  FAIL" : "");
+        return failed ? 1 : 0;
+    }
+
+    // A bounce: the host is non-realtime from prepareToPlay on and sends blocks of any size up to
+    // the one it announced. Frames run synchronously, so nothing is ever missed and the output has
+    // to be exactly the input delayed by the reported latency, which has to be the one playback
+    // reports for the same settings and block size.
+    struct OfflineScenario
+    {
+        const char* name;
+        int maxBlockSize;
+        int latencyMode;        // 1 low, 2 high quality
+        bool statefulModel;
+    };
+
+    int runOfflineScenario(const OfflineScenario& scenario)
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numChannels = 2;
+        constexpr int numSamples = 96000;
+        constexpr float tolerance = 1.0e-4f;
+
+        int realtimeLatency = 0;
+        {
+            TitanVocalProcessor processor;
+            prepareAIProcessor(processor, sampleRate, scenario.maxBlockSize, scenario.latencyMode, scenario.statefulModel);
+            realtimeLatency = processor.getLatencySamples();
+            processor.releaseResources();
+        }
+
+        TitanVocalProcessor processor;
+        processor.setNonRealtime(true);
+        prepareAIProcessor(processor, sampleRate, scenario.maxBlockSize, scenario.latencyMode, scenario.statefulModel);
+        const int latency = processor.getLatencySamples();
+
+        std::vector<float> input;
+        std::vector<float> output[numChannels];
+        input.reserve((size_t) numSamples);
+        for (auto& channel : output)
+            channel.reserve((size_t) numSamples);
+
+        juce::AudioBuffer<float> buffer (numChannels, scenario.maxBlockSize);
+        juce::MidiBuffer midi;
+        VocalSignal signal (sampleRate);
+        juce::Random random (42);
+
+        for (int done = 0; done < numSamples;)
+        {
+            const int blockSize = juce::jmin(numSamples - done, 1 + random.nextInt(scenario.maxBlockSize));
+            juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), numChannels, blockSize);
+            signal.fill(block);
+            input.insert(input.end(), block.getReadPointer(0), block.getReadPointer(0) + blockSize);
+            processor.processBlock(block, midi);
+            for (int ch = 0; ch < numChannels; ++ch)
+                output[ch].insert(output[ch].end(), block.getReadPointer(ch), block.getReadPointer(ch) + blockSize);
+            done += blockSize;
+        }
+        processor.releaseResources();
+
+        // The first latency's worth of output is the DSP chain while the AI stream fills
+        float maxError = 0.0f;
+        for (const auto& channel : output)
+            for (size_t i = (size_t) latency; i < channel.size(); ++i)
+                maxError = juce::jmax(maxError, std::abs(channel[i] - input[i - (size_t) latency]));
+
+        const bool failed = latency <= 0 || latency != realtimeLatency || maxError > tolerance;
+        std::printf("%-28s block <= %4d  latency %5d (realtime %5d)  max error %.2e%s\n", scenario.name,
+                    scenario.maxBlockSize, latency, realtimeLatency, (double) maxError, failed ? "  FAIL" : "");
+        return failed ? 1 : 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args (argc, argv);
+    RealtimeSanitizer::setPrintStackTraces(! args.containsOption("--quiet"));
+
+    const Scenario scenarios[] = {
+        { "dsp default",        512, 2, false, 0.1f, 0.2f,  0.0f,  2 },
+        { "dsp small block",     32, 2, false, 0.2f, 0.3f,  2.0f,  2 },
+        { "dsp mono",            64, 1, false, 0.0f, 0.0f, -3.0f,  2 },
+        { "dsp odd block",      333, 2, false, 0.5f, 0.5f,  5.0f,  2 },
+        { "ai enabled",         256, 2, true,  0.2f, 0.3f,  2.0f,  2 },
+        { "ai enabled small",    64, 2, true,  0.2f, 0.3f,  0.0f,  2 },
+        { "dsp 6ch parallel",   256, 6, false, 0.2f, 0.3f,  2.0f,  2 },
+        { "ai enabled 6ch",     128, 6, true,  0.2f, 0.3f,  0.0f,  2 },
+        { "zero latency",        32, 2, false, 0.2f, 0.3f,  2.0f,  0 },
+        { "ai low latency",     128, 2, true,  0.2f, 0.3f,  0.0f,  1 },
+        { "ai mode switching",  256, 2, true,  0.2f, 0.3f,  2.0f, -1 },
+        { "ai stateful",        128, 2, true,  0.2f, 0.3f,  0.0f,  1, true },
+    };
+
+    const TimingScenario timingScenarios[] = {
+        { "ai timing high quality",  512, 2, false },
+        { "ai timing high quality", 1024, 2, false },
+        { "ai timing low latency",   512, 1, false },
+        { "ai timing stateful",     1024, 1, true },
+    };
+
+    // Timing runs depend on the machine's load, so they only run on request (their own ctest)
+    if (args.containsOption("--timing"))
+    {
+        int timingFailures = 0;
+        for (const auto& scenario : timingScenarios)
+            timingFailures += runTimingScenario(scenario);
+
+        std::printf("%s: %d AI timing failure(s)\n", timingFailures == 0 ? "PASS" : "FAIL", timingFailures);
+        return timingFailures == 0 ? 0 : 1;
+    }
+
+    const OfflineScenario offlineScenarios[] = {
+        { "offline high quality",    512, 2, false },
+        { "offline low latency",    1024, 1, false },
+        { "offline stateful",        256, 1, true },
+        { "offline stateful hq",     512, 2, true },
+    };
+
+    int total = 0;
+    for (const auto& scenario : scenarios)
+        total += runScenario(scenario);
+
+    // Bounces are not real-time (stateful models set up their state on the first frame), so only
+    // their output is checked
+    RealtimeSanitizer::setPrintStackTraces(false);
+    int offlineFailures = 0;
+    for (const auto& scenario : offlineScenarios)
+        offlineFailures += runOfflineScenario(scenario);
+
+    const bool passed = total == 0 && offlineFailures == 0;
+    std::printf("%s: %d real-time safety violation(s), %d offline alignment failure(s)\n", passed ? "PASS" : "FAIL",
+                total, offlineFailures);
+    return passed ? 0 : 1;
+}
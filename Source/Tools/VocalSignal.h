@@ -0,0 +1,38 @@
+// TitanVocal - Proprietary Synthetic Vocal Signal
+// Copyright (c) 2025 Ray Flanary and Joni Marie Flanary. All rights reserved.
+// Licensed under strict proprietary EULA in LICENSE.txt.
+//
+// File: VocalSignal.h
+// Description: Deterministic vowel-like test signal shared by the headless check and benchmark drivers.
+#pragma once
+
+#include <JuceHeader.h>
+
+// A 180 Hz harmonic stack with slow vibrato, a 1/h spectral tilt and a little breath noise. Every
+// channel gets the same signal. Seeded, so runs are comparable.
+class VocalSignal
+{
+public:
+    explicit VocalSignal(double sampleRateToUse, juce::int64 seed = 1234)
+        : sampleRate(sampleRateToUse), rng(seed) {}
+
+    void fill(juce::AudioBuffer<float>& buffer)
+    {
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        {
+            const double f0 = 180.0 * (1.0 + 0.01 * std::sin(phase * 0.03));
+            phase += juce::MathConstants<double>::twoPi * f0 / sampleRate;
+            float v = 0.0f;
+            for (int h = 1; h <= 8; ++h)
+                v += (float) (std::sin(phase * h) / h);
+            v = 0.2f * v + 0.005f * (rng.nextFloat() * 2.0f - 1.0f);
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                buffer.setSample(ch, i, v);
+        }
+    }
+
+private:
+    double sampleRate;
+    double phase = 0.0;
+    juce::Random rng;
+};